@@ -49,6 +49,7 @@
 #include <sid_pal_log_ifc.h>
 
 #include <sl_spidrv_exp_config.h>
+#include "sl_spidrv_instances.h"
 #define SL_SPI_PERIPHERAL_ID         SL_SPIDRV_EXP_PERIPHERAL
 #define SL_SPI_PERIPHERAL_BITRATE    SL_SPIDRV_EXP_BITRATE
 #define SL_SPI_PERIPHERAL_CLOCK_MODE SL_SPIDRV_EXP_CLOCK_MODE
@@ -132,6 +133,7 @@ static const radio_sx126x_regional_param_t radio_sx126x_regional_param[] =
 static const struct sid_pal_serial_bus_efr32_spi_config radio_spi_config =
 {
   .peripheral_id = SL_SPI_PERIPHERAL_ID,
+  .spidrv_handle = &sl_spidrv_exp_handle,
 };
 
 static const struct sid_pal_serial_bus_factory radio_spi_factory =
@@ -152,6 +154,7 @@ const radio_sx126x_device_config_t radio_sx1262_cfg = {
 #endif
   .lna_gain                   = RADIO_RX_LNA_GAIN,
   .bus_factory                = &radio_spi_factory,
+  .bus_xfer_async             = sid_pal_serial_bus_efr32_spi_xfer_async,
   .gpio_power                 = SL_PIN_NRESET,
   .gpio_int1                  = SL_PIN_DIO,
   .gpio_radio_busy            = SL_PIN_BUSY,
@@ -93,6 +93,18 @@ typedef int32_t (*radio_sx126x_get_mfg_trim_val_t)(uint16_t *trim);
 // DIO3 out voltage to supply antenna switch power.
 typedef int32_t (*radio_sx126x_get_dio3_cfg_t)(void);
 
+// Completion of a non blocking bus transfer, called from interrupt context.
+typedef void (*radio_sx126x_bus_xfer_done_t)(sid_error_t status, void *arg);
+
+// Non blocking full duplex transfer on the radio bus, optional.
+typedef sid_error_t (*radio_sx126x_bus_xfer_async_t)(const struct sid_pal_serial_bus_iface *iface,
+                                                     const struct sid_pal_serial_bus_client *client,
+                                                     uint8_t *tx,
+                                                     uint8_t *rx,
+                                                     size_t xfer_size,
+                                                     radio_sx126x_bus_xfer_done_t done,
+                                                     void *arg);
+
 typedef struct {
     uint8_t id;
     uint8_t regulator_mode;
@@ -102,6 +114,7 @@ typedef struct {
     const radio_sx126x_get_mfg_trim_val_t trim_cap_val_callback;
     const radio_sx126x_get_dio3_cfg_t dio3_cfg_callback;
     const struct sid_pal_serial_bus_factory *bus_factory;
+    const radio_sx126x_bus_xfer_async_t bus_xfer_async;
 
     uint32_t gpio_power;
     uint32_t gpio_int1;
@@ -39,6 +39,15 @@ typedef enum {
     RADIO_FSK_RX_DONE_STATUS_SW_MARK_NOT_PRESENT = 6,
 } radio_fsk_rx_done_status_t;
 
+#define SX126X_BATCH_MAX_CMDS                       8
+
+/* Settings of the shadow configuration */
+#define SX126X_SHADOW_FREQ                          (1 << 0)
+#define SX126X_SHADOW_TX_POWER                      (1 << 1)
+#define SX126X_SHADOW_LORA_MOD_PARAMS               (1 << 2)
+#define SX126X_SHADOW_FSK_PKT_PARAMS                (1 << 3)
+#define SX126X_SHADOW_ALL                           (0x0F)
+
 typedef struct {
     const radio_sx126x_device_config_t           *config;
     const struct sid_pal_serial_bus_iface        *bus_iface;
@@ -59,8 +68,40 @@ typedef struct {
     uint16_t                                     trim;
     uint32_t                                     radio_freq_hz;
     radio_sx126x_regional_param_t                regional_radio_param;
+
+    struct {
+        uint8_t                                  depth;
+        uint8_t                                  count;
+        uint16_t                                 used;
+        uint16_t                                 length[SX126X_BATCH_MAX_CMDS];
+    } batch;
+    volatile bool                                xfer_pending;
+    volatile int32_t                             xfer_status;
+
+    /* Last configuration applied to the radio, lost on sleep and reset */
+    struct {
+        uint8_t                                  valid;
+        int8_t                                   tx_power;
+        sx126x_mod_params_lora_t                 lora_mod_params;
+        sx126x_pkt_params_gfsk_t                 fsk_pkt_params;
+    } shadow;
 } halo_drv_semtech_ctx_t;
 
+typedef struct {
+    uint32_t                                     calls;          // commands and wake ups waiting on BUSY
+    uint32_t                                     waits;          // of which found the radio busy
+    uint32_t                                     blocked_waits;  // of which slept on the BUSY interrupt
+    uint32_t                                     timeouts;
+    uint32_t                                     max_us;
+    uint64_t                                     total_us;
+} sx126x_radio_busy_stats_t;
+
+typedef struct {
+    uint32_t                                     packets;        // TX and RX windows started
+    uint32_t                                     skipped;        // settings found already applied
+    uint32_t                                     saved_xfers;    // bus transactions not sent for them
+} sx126x_radio_shadow_stats_t;
+
 /* enum for calibration bands in semtech radio */
 typedef enum {
     SX126X_BAND_900M,
@@ -111,6 +152,13 @@ const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void);
 
 int32_t sx126x_wait_on_busy(void);
 
+/*!
+ * @brief Time spent waiting on the BUSY line since boot or the last reset
+ */
+void sx126x_radio_get_busy_stats(sx126x_radio_busy_stats_t *stats);
+
+void sx126x_radio_reset_busy_stats(void);
+
 void set_gpio_cfg_awake(const halo_drv_semtech_ctx_t *drv_ctx);
 
 void set_gpio_cfg_sleep(const halo_drv_semtech_ctx_t *drv_ctx);
@@ -118,6 +166,54 @@ void set_gpio_cfg_sleep(const halo_drv_semtech_ctx_t *drv_ctx);
 int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, const uint16_t cmd_buffer_size, uint8_t *buffer,
                               const uint16_t size, uint8_t read_offset);
 
+/*!
+ * @brief Queue the following commands instead of sending them one by one
+ *
+ * Commands written to the radio are laid out back to back in the internal
+ * buffer until the matching sx126x_radio_batch_commit() is called. Batches can
+ * be nested, the outermost commit sends. A read sends the queued commands
+ * first. Errors of queued commands are reported by the commit.
+ */
+void sx126x_radio_batch_begin(void);
+
+/*!
+ * @brief Close the batch and send the queued commands if it is the outermost
+ *
+ * The last command can still be on the bus when the function returns, the
+ * next access to the radio waits for it.
+ */
+int32_t sx126x_radio_batch_commit(void);
+
+bool sx126x_radio_batch_is_open(void);
+
+int32_t sx126x_radio_batch_queue(const uint8_t *cmd_buffer, uint16_t cmd_buffer_size, const uint8_t *buffer,
+                                 uint16_t size);
+
+int32_t sx126x_radio_batch_flush(void);
+
+/*!
+ * @brief Check the LoRa modulation parameters against the shadow configuration
+ * @return true if the radio already runs with them, the write can be skipped
+ */
+bool sx126x_radio_shadow_has_lora_mod_params(const sx126x_mod_params_lora_t *params);
+
+void sx126x_radio_shadow_set_lora_mod_params(const sx126x_mod_params_lora_t *params);
+
+/*!
+ * @brief Check the FSK packet parameters against the shadow configuration
+ * @return true if the radio already runs with them, the write can be skipped
+ */
+bool sx126x_radio_shadow_has_fsk_pkt_params(const sx126x_pkt_params_gfsk_t *params);
+
+void sx126x_radio_shadow_set_fsk_pkt_params(const sx126x_pkt_params_gfsk_t *params);
+
+/*!
+ * @brief Settings skipped thanks to the shadow configuration since boot or the last reset
+ */
+void sx126x_radio_get_shadow_stats(sx126x_radio_shadow_stats_t *stats);
+
+void sx126x_radio_reset_shadow_stats(void);
+
 int32_t radio_sx126x_set_radio_mode(bool rf_en, bool tx_en);
 
 int32_t radio_lora_process_rx_done(halo_drv_semtech_ctx_t *drv_ctx);
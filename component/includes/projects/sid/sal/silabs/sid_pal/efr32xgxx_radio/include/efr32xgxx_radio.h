@@ -55,6 +55,17 @@ extern "C" {
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+// Settings of the shadow configuration
+#define EFR32XGXX_SHADOW_FSK_MOD_PARAMS                (1 << 0)
+#define EFR32XGXX_SHADOW_FSK_PKT_PARAMS                (1 << 1)
+#define EFR32XGXX_SHADOW_ALL                           (0x03)
+
+typedef struct {
+  uint32_t                                     packets;        // TX and RX windows started
+  uint32_t                                     skipped;        // settings found already applied
+  uint32_t                                     saved_reinits;  // RAIL channel reconfigurations among them
+} efr32xgxx_shadow_stats_t;
+
 typedef struct {
   const radio_efr32xgxx_device_config_t        *config;
   sid_pal_radio_modem_mode_t                   modem;
@@ -65,6 +76,13 @@ typedef struct {
   sid_pal_radio_cad_param_exit_mode_t          cad_exit_mode;
   uint32_t                                     radio_freq_hz;
   radio_efr32xgxx_regional_param_t             regional_radio_param;
+  // Last configuration applied to the radio, lost on sleep and init
+  struct {
+    uint8_t                                    valid;
+    uint32_t                                   br_in_bps;
+    uint16_t                                   pbl_len_in_bits;
+  } shadow;
+  efr32xgxx_shadow_stats_t                     shadow_stats;
 } halo_drv_silabs_ctx_t;
 
 #define US_IN_SEC                                      (1000000UL)
@@ -77,6 +95,17 @@ halo_drv_silabs_ctx_t* efr32xgxx_get_drv_ctx(void);
 
 int32_t radio_fsk_process_rx_done(const halo_drv_silabs_ctx_t *drv_ctx);
 
+/*******************************************************************************
+ * Provides the settings skipped thanks to the shadow configuration
+ * @param[out] stats statistics collected since boot or the last reset
+ ******************************************************************************/
+void efr32xgxx_get_shadow_stats(efr32xgxx_shadow_stats_t *stats);
+
+/*******************************************************************************
+ * Resets the shadow configuration statistics
+ ******************************************************************************/
+void efr32xgxx_reset_shadow_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -214,6 +214,8 @@ int32_t efr32xgxx_set_tx_cw(void);
 int32_t efr32xgxx_set_tx_cpbl(void);
 int32_t efr32xgxx_set_rf_freq(const uint32_t freq_in_hz);
 int32_t efr32xgxx_get_rssi_inst(int16_t* rssi_in_dbm);
+int32_t efr32xgxx_get_rssi_avg(uint32_t averaging_time_us, int16_t *rssi_in_dbm);
+int32_t efr32xgxx_detect_rssi_above(int16_t threshold, uint32_t window_us, bool *detected);
 int32_t efr32xgxx_get_random_numbers(uint32_t* numbers, unsigned int n);
 uint32_t efr32xgxx_get_gfsk_time_on_air_in_ms(const efr32xgxx_pkt_params_gfsk_t* pkt_p,
                                               const efr32xgxx_mod_params_gfsk_t* mod_p);
@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ * @file
+ * @brief crypto_ecc_pool.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef CRYPTO_ECC_POOL_H
+#define CRYPTO_ECC_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  uint32_t hits;                // key pairs handed out from the pool
+  uint32_t misses;              // key pairs generated inline, the pool was empty
+  uint32_t refills;             // key pairs generated by the refill task
+  uint8_t p256_available;
+  uint8_t x25519_available;
+} sli_sid_pal_crypto_ecc_pool_stats_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Gives the statistics of the pre-generated ECDH key pool, all zero if the
+ * pool is disabled.
+ ******************************************************************************/
+void sli_sid_pal_crypto_get_ecc_pool_stats(sli_sid_pal_crypto_ecc_pool_stats_t *stats);
+
+/*******************************************************************************
+ * Clears the hit, miss and refill counters.
+ ******************************************************************************/
+void sli_sid_pal_crypto_reset_ecc_pool_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_ECC_POOL_H */
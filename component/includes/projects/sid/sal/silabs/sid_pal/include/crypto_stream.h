@@ -0,0 +1,171 @@
+/***************************************************************************//**
+ * @file
+ * @brief crypto_stream.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef CRYPTO_STREAM_H
+#define CRYPTO_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/crypto.h"
+#include <sid_error.h>
+#include <sid_pal_crypto_ifc.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// One piece of a scattered input, e.g. a frame header or its payload
+typedef struct {
+  uint8_t const *data;
+  size_t size;
+} sli_sid_pal_crypto_chunk_t;
+
+typedef enum {
+  SLI_SID_PAL_CRYPTO_STREAM_IDLE = 0,
+  SLI_SID_PAL_CRYPTO_STREAM_CIPHER,
+  SLI_SID_PAL_CRYPTO_STREAM_MAC,
+  SLI_SID_PAL_CRYPTO_STREAM_AEAD,
+  SLI_SID_PAL_CRYPTO_STREAM_HASH,
+} sli_sid_pal_crypto_stream_kind_t;
+
+// Multi-part operation, to be treated as opaque. A zero initialized stream is
+// idle, it is idle again after the finish, an abort or any failed call.
+typedef struct {
+  sli_sid_pal_crypto_stream_kind_t kind;
+  sid_pal_aes_mode_t mode;
+  psa_key_id_t key_id;
+  size_t tag_size;
+  union {
+    psa_cipher_operation_t cipher;
+    psa_mac_operation_t mac;
+    psa_aead_operation_t aead;
+    psa_hash_operation_t hash;
+  } op;
+} sli_sid_pal_crypto_stream_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Starts an AES-CMAC or AES-CTR stream. The algorithm, mode, key and IV are
+ * taken from params, the in and out buffers are not used.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_aes_start(sli_sid_pal_crypto_stream_t *stream,
+                                         const sid_pal_aes_params_t *params);
+
+/*******************************************************************************
+ * Starts an AEAD stream. Besides the algorithm, mode, key, IV and MAC size,
+ * aad_size and in_size have to give the total lengths fed later, CCM needs
+ * them up front. The buffers of params are not used.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_aead_start(sli_sid_pal_crypto_stream_t *stream,
+                                          const sid_pal_aead_params_t *params);
+
+/*******************************************************************************
+ * Starts a hash stream, e.g. for blobs too large to be copied into RAM.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_hash_start(sli_sid_pal_crypto_stream_t *stream,
+                                          sid_pal_hash_algo_t algo);
+
+/*******************************************************************************
+ * Feeds additional authenticated data to an AEAD stream. All of it has to be
+ * fed before the first sli_sid_pal_crypto_stream_update().
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_stream_update_ad(sli_sid_pal_crypto_stream_t *stream,
+                                                uint8_t const *aad,
+                                                size_t aad_size);
+
+/*******************************************************************************
+ * Feeds input to a stream. Ciphers write the output produced so far to out
+ * and its length to out_len, MAC and hash streams take NULL for both.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_stream_update(sli_sid_pal_crypto_stream_t *stream,
+                                             uint8_t const *in,
+                                             size_t in_size,
+                                             uint8_t *out,
+                                             size_t out_size,
+                                             size_t *out_len);
+
+/*******************************************************************************
+ * Completes a stream. Ciphers write the output still pending to out, out_len
+ * may be NULL for MAC and hash streams. The MAC, the digest or the AEAD tag is
+ * written to tag, AEAD decryption verifies the tag instead.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_stream_finish(sli_sid_pal_crypto_stream_t *stream,
+                                             uint8_t *out,
+                                             size_t out_size,
+                                             size_t *out_len,
+                                             uint8_t *tag,
+                                             size_t tag_size);
+
+/*******************************************************************************
+ * Cancels a stream, does nothing on an idle one.
+ ******************************************************************************/
+void sli_sid_pal_crypto_stream_abort(sli_sid_pal_crypto_stream_t *stream);
+
+/*******************************************************************************
+ * Same as sid_pal_crypto_aes_crypt() with the input given as a list of chunks
+ * instead of params->in and params->in_size.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_aes_crypt_sg(sid_pal_aes_params_t *params,
+                                            const sli_sid_pal_crypto_chunk_t *in,
+                                            size_t in_count);
+
+/*******************************************************************************
+ * Same as sid_pal_crypto_aead_crypt() with the additional data and the input
+ * given as lists of chunks instead of the aad and in buffers of params. Unlike
+ * it, no buffer is allocated for the ciphertext and the MAC.
+ ******************************************************************************/
+sid_error_t sli_sid_pal_crypto_aead_crypt_sg(sid_pal_aead_params_t *params,
+                                             const sli_sid_pal_crypto_chunk_t *aad,
+                                             size_t aad_count,
+                                             const sli_sid_pal_crypto_chunk_t *in,
+                                             size_t in_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_STREAM_H */
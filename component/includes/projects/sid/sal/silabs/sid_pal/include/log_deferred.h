@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ * @file
+ * @brief log_deferred.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef LOG_DEFERRED_H
+#define LOG_DEFERRED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Deferred log records are little endian 32-bit words:
+//   word 0: length in words, severity, truncated flag and sequence number
+//   word 1: uptime in milliseconds
+//   word 2: address of the format string in the firmware image
+//   word 3..: arguments in the order of the format string conversions.
+//     Integers, characters and pointers take a word, doubles and 64-bit
+//     integers take two words, low word first. A string takes a word with its
+//     length, then its characters zero padded to a word boundary.
+#define SLI_LOG_RECORD_FIXED_WORDS        (3U)
+#define SLI_LOG_RECORD_LENGTH_MASK        (0x000000FFUL)
+#define SLI_LOG_RECORD_SEVERITY_SHIFT     (8U)
+#define SLI_LOG_RECORD_SEVERITY_MASK      (0x0000007FUL)
+#define SLI_LOG_RECORD_TRUNCATED          (0x00008000UL)
+#define SLI_LOG_RECORD_SEQUENCE_SHIFT     (16U)
+
+// Records are printed by the drain task as this prefix and 8 hex digits per word
+#define SLI_LOG_RECORD_LINE_PREFIX        "#SIDLOG:"
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Creates the task printing the deferred log records when the deferred log
+ * and its drain task are enabled, does nothing otherwise
+ ******************************************************************************/
+void sli_sid_pal_log_init(void);
+
+/*******************************************************************************
+ * Prints the crash ring records of the previous run as hex lines for the host
+ * side decoder, does nothing if the crash ring is disabled
+ ******************************************************************************/
+void sli_sid_pal_log_crash_print(void);
+
+/*******************************************************************************
+ * Clears the crash ring records of the previous run
+ ******************************************************************************/
+void sli_sid_pal_log_crash_clear(void);
+
+/*******************************************************************************
+ * Records an assert in the crash ring, called before the device stops
+ * @param[in] line line number of the assert
+ * @param[in] file file name of the assert
+ ******************************************************************************/
+void sli_sid_pal_log_crash_assert(int line, const char *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_DEFERRED_H */
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file
+ * @brief log_module.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <sid_pal_log_ifc.h>
+// Not available to the bare-metal projects, e.g. the PDP provisioner
+#if defined(__has_include)
+#if __has_include("sl_sidewalk_pal_config.h")
+#include "sl_sidewalk_pal_config.h"
+#endif
+#endif
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Per-module compile-time log level. A PAL module includes this header instead
+// of sid_pal_log_ifc.h and defines SLI_SID_PAL_LOG_MODULE_LEVEL to one of the
+// SL_SIDEWALK_PAL_LOG_LEVEL_* settings. Warning, info and debug calls above the
+// module level or above SID_PAL_LOG_LEVEL are folded away by the compiler
+// together with their format strings, the arguments are still type checked.
+// Errors are always kept, the remaining calls are filtered at runtime by
+// sid_log_control as before.
+#define SLI_SID_PAL_LOG_MODULE(level_, fmt_, ...)           \
+  do {                                                      \
+    if (((level_) <= (SLI_SID_PAL_LOG_MODULE_LEVEL))        \
+        && ((level_) <= (SID_PAL_LOG_LEVEL))) {             \
+      SID_PAL_LOG(level_, fmt_, ##__VA_ARGS__);             \
+    }                                                       \
+  } while (0)
+
+// Without the PAL config only SID_PAL_LOG_LEVEL applies
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_TIMER
+#define SL_SIDEWALK_PAL_LOG_LEVEL_TIMER SID_PAL_LOG_SEVERITY_DEBUG
+#endif
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_RADIO
+#define SL_SIDEWALK_PAL_LOG_LEVEL_RADIO SID_PAL_LOG_SEVERITY_DEBUG
+#endif
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_BLE
+#define SL_SIDEWALK_PAL_LOG_LEVEL_BLE SID_PAL_LOG_SEVERITY_DEBUG
+#endif
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE
+#define SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE SID_PAL_LOG_SEVERITY_DEBUG
+#endif
+
+#undef SID_PAL_LOG_WARNING
+#undef SID_PAL_LOG_INFO
+#undef SID_PAL_LOG_DEBUG
+#define SID_PAL_LOG_WARNING(fmt_, ...) SLI_SID_PAL_LOG_MODULE(SID_PAL_LOG_SEVERITY_WARNING, fmt_, ##__VA_ARGS__)
+#define SID_PAL_LOG_INFO(fmt_, ...)    SLI_SID_PAL_LOG_MODULE(SID_PAL_LOG_SEVERITY_INFO, fmt_, ##__VA_ARGS__)
+#define SID_PAL_LOG_DEBUG(fmt_, ...)   SLI_SID_PAL_LOG_MODULE(SID_PAL_LOG_SEVERITY_DEBUG, fmt_, ##__VA_ARGS__)
+
+#endif /* LOG_MODULE_H */
@@ -80,6 +80,20 @@ extern "C" {
 #define SLI_SID_NVM3_VALIDATE_KEY(region, key)    ((uint32_t)key <= SLI_SID_NVM3_KEY_MAX_##region##_REL)
 #define SLI_SID_NVM3_MAP_KEY(region, key)         (SLI_SID_NVM3_KEY_BASE_##region + (uint32_t)key)
 
+// Last KV group, not used by the stack (see sid_pal_storage_kv_internal_group_ids.h)
+#define SLI_SID_NVM3_KV_JOURNAL_GROUP             SLI_SID_NVM3_KEY_MAX_KV_REL
+
+typedef struct {
+  uint32_t requests;            // writes after which NVM3 needed a repack
+  uint32_t stalls_avoided;      // requests handed over to the repack task
+  uint32_t deadline_repacks;    // requests repacked inline, deadline elapsed
+  uint32_t repack_count;        // nvm3_repack() calls, inline and deferred
+  uint32_t repack_errors;
+  uint32_t last_duration_ms;
+  uint32_t max_duration_ms;
+  uint32_t total_duration_ms;
+} sli_sid_nvm3_repack_stats_t;
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -95,6 +109,25 @@ extern "C" {
  ******************************************************************************/
 sid_error_t sli_sid_nvm3_convert_ecode_to_sid_error(Ecode_t nvm3_return_code);
 
+/*******************************************************************************
+ * Creates the repack task, safe to be called more than once
+ ******************************************************************************/
+void sli_sid_nvm3_repack_init(void);
+
+/*******************************************************************************
+ * To be called after writing the default NVM3 instance. If a repack is
+ * needed, it is deferred to the repack task, or done inline when the task
+ * does not run or the repack is pending for longer than the deadline.
+ * @return ECODE_NVM3_OK if no repack is needed, it is deferred or it succeeded
+ ******************************************************************************/
+Ecode_t sli_sid_nvm3_repack_request(void);
+
+/*******************************************************************************
+ * Provides the repack statistics
+ * @param[out] stats statistics collected since boot
+ ******************************************************************************/
+void sli_sid_nvm3_get_repack_stats(sli_sid_nvm3_repack_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,139 @@
+/***************************************************************************//**
+ * @file
+ * @brief radio_noise.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef RADIO_NOISE_H
+#define RADIO_NOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  uint32_t freq;                // channel frequency [Hz]
+  int16_t noise;                // smoothed noise floor [dBm]
+  uint8_t occupancy;            // smoothed share of the channel found busy [%]
+  uint32_t noise_age_ms;        // time since the last noise sample
+} sli_sid_pal_radio_noise_entry_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Feeds a noise sample of a channel to the noise table. Samples within the
+ * maximum age are averaged with the stored noise floor. Can be called from
+ * interrupt context.
+ * @param[in] freq channel frequency [Hz]
+ * @param[in] rssi RSSI measured while nothing was received [dBm]
+ ******************************************************************************/
+void sli_sid_pal_radio_noise_update(uint32_t freq, int16_t rssi);
+
+/*******************************************************************************
+ * Feeds a single RSSI sample of a channel, e.g. of an empty receive window, to
+ * the noise table. It is only averaged with a fresh noise floor and does not
+ * make it any younger. Can be called from interrupt context.
+ * @param[in] freq channel frequency [Hz]
+ * @param[in] rssi RSSI measured while nothing was received [dBm]
+ ******************************************************************************/
+void sli_sid_pal_radio_noise_sample(uint32_t freq, int16_t rssi);
+
+/*******************************************************************************
+ * Feeds an occupancy observation of a channel to the noise table, e.g. the
+ * result of a carrier sense or a received packet. Can be called from
+ * interrupt context.
+ * @param[in] freq channel frequency [Hz]
+ * @param[in] busy true if the channel was found busy
+ ******************************************************************************/
+void sli_sid_pal_radio_noise_mark_busy(uint32_t freq, bool busy);
+
+/*******************************************************************************
+ * Provides the noise floor of a channel if sampled within the maximum age,
+ * never if the maximum age is 0
+ * @param[in] freq channel frequency [Hz]
+ * @param[out] noise noise floor [dBm]
+ * @return true if a fresh noise floor was found
+ ******************************************************************************/
+bool sli_sid_pal_radio_noise_get(uint32_t freq, int16_t *noise);
+
+/*******************************************************************************
+ * Provides the noise table entry of a channel, however old it is
+ * @param[in] freq channel frequency [Hz]
+ * @param[out] entry noise table entry
+ * @return true if the channel is in the table
+ ******************************************************************************/
+bool sli_sid_pal_radio_noise_get_entry(uint32_t freq, sli_sid_pal_radio_noise_entry_t *entry);
+
+/*******************************************************************************
+ * Selects the channel with the lowest fresh noise floor, occupancy breaks
+ * ties
+ * @param[in] freqs channel frequencies [Hz]
+ * @param[in] count number of channels
+ * @return index of the quietest channel in freqs, count if none is fresh
+ ******************************************************************************/
+uint8_t sli_sid_pal_radio_noise_quietest(const uint32_t *freqs, uint8_t count);
+
+/*******************************************************************************
+ * Forgets all the channels of the noise table, e.g. after a region change
+ ******************************************************************************/
+void sli_sid_pal_radio_noise_flush(void);
+
+/*******************************************************************************
+ * Measures the noise floor of several channels in a row and feeds them to the
+ * noise table. Implemented by the radio driver.
+ * @param[in] freqs channel frequencies [Hz]
+ * @param[out] noise noise floor per channel [dBm]
+ * @param[in] count number of channels
+ * @return RADIO_ERROR_NONE or the error of the first failing channel
+ ******************************************************************************/
+int32_t sli_sid_pal_radio_survey_noise(const uint32_t *freqs, int16_t *noise, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADIO_NOISE_H */
@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ * @file
+ * @brief timer_stats.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef TIMER_STATS_H
+#define TIMER_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+typedef struct {
+  uint32_t arms;
+  uint32_t fires;
+  uint32_t coalesced_fires;     // fires served by a wakeup due to an other timer or event
+  uint32_t armed;               // timers armed at the moment
+  uint32_t avg_lateness_us;
+  uint32_t max_lateness_us;
+} sli_sid_pal_timer_class_stats_t;
+
+typedef struct {
+  uint32_t wakeups;             // sleeptimer expiries
+  sli_sid_pal_timer_class_stats_t precise;
+  sli_sid_pal_timer_class_stats_t lowpower;
+} sli_sid_pal_timer_stats_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Pulls the sleeptimer forward if LOWPOWER timers are expired but waiting
+ * within their slack, they are then served from the sleeptimer callback. To be
+ * called when the device is awake for an other reason, e.g. a radio event.
+ ******************************************************************************/
+void sli_sid_pal_timer_align_wakeup(void);
+
+/*******************************************************************************
+ * Provides the statistics of the sid_pal timers per priority class
+ * @param[out] stats statistics collected since boot or the last reset
+ ******************************************************************************/
+void sli_sid_pal_timer_get_stats(sli_sid_pal_timer_stats_t *stats);
+
+/*******************************************************************************
+ * Resets the statistics of the sid_pal timers
+ ******************************************************************************/
+void sli_sid_pal_timer_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMER_STATS_H */
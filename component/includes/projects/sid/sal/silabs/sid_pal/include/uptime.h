@@ -0,0 +1,76 @@
+/***************************************************************************//**
+ * @file
+ * @brief uptime.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef UPTIME_H
+#define UPTIME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <sid_time_types.h>
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Converts an uptime to sleeptimer ticks, compensated by the crystal offset
+ * and rounded up not to expire early. Uptimes in the past are converted to a
+ * tick not later than the current one.
+ * @param[in] time uptime as returned by sid_pal_uptime_now()
+ * @return sleeptimer tick count reached at the uptime
+ ******************************************************************************/
+uint64_t sli_sid_pal_uptime_to_tick(const struct sid_timespec * time);
+
+/*******************************************************************************
+ * Converts the armed timers again after a crystal offset change. Implemented
+ * by the timer module, called by sid_pal_uptime_set_xtal_ppm(). The weak
+ * default of the uptime module does nothing.
+ ******************************************************************************/
+void sli_sid_pal_timer_xtal_ppm_changed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UPTIME_H */
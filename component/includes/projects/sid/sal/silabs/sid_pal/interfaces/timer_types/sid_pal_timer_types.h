@@ -66,11 +66,11 @@ typedef void (* sid_pal_timer_cb_t)(void * arg,
 struct sid_pal_timer_impl_t{
   struct sid_timespec alarm;
   struct sid_timespec period;
-  sl_sleeptimer_timer_handle_t sleeptimer_handle;
+  uint64_t expiry_tick;
   sid_pal_timer_cb_t callback;
   bool is_periodic;
-  bool has_started;
-  uint32_t period_in_ms;
+  uint8_t prio_class;
+  uint16_t heap_pos;          // position in the armed timer heap + 1, 0 if not armed
   void * callback_arg;
 };
 
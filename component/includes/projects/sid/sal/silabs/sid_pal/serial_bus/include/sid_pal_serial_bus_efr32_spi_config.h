@@ -52,6 +52,8 @@
     #error UNSUPPORTED PLATFORM!
 #endif
 
+#include <spidrv.h>
+
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -60,10 +62,39 @@ extern "C" {
 
 struct sid_pal_serial_bus_efr32_spi_config {
   USART_INSTANCE_TYPE *peripheral_id;
+  // SPIDRV instance driving the same peripheral, NULL to transfer without DMA
+  SPIDRV_Handle_t *spidrv_handle;
 };
 
+/*******************************************************************************
+ * Called from interrupt context once an asynchronous transfer is over and the
+ * client is deselected
+ ******************************************************************************/
+typedef void (*sid_pal_serial_bus_efr32_spi_xfer_done_t)(sid_error_t status, void *arg);
+
 sid_error_t sid_pal_serial_bus_efr32_spi_create(const struct sid_pal_serial_bus_iface **iface, const void *cfg);
 
+/*******************************************************************************
+ * Starts a full duplex DMA transfer and returns without waiting for it. A
+ * single transfer can be in flight, the bus reports SID_ERROR_BUSY until the
+ * done callback has been called.
+ * @param[in] iface pointer to serial bus interface
+ * @param[in] client pointer to serial bus client
+ * @param[in] tx pointer to the message to be sent, kept until done
+ * @param[out] rx pointer to the message to be received, kept until done
+ * @param[in] xfer_size length of the message sent and received
+ * @param[in] done completion callback, can be NULL
+ * @param[in] arg argument of the completion callback
+ * @return SID_ERROR_NOSUPPORT if the bus has no SPIDRV instance
+ ******************************************************************************/
+sid_error_t sid_pal_serial_bus_efr32_spi_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+                                                   const struct sid_pal_serial_bus_client *client,
+                                                   uint8_t *tx,
+                                                   uint8_t *rx,
+                                                   size_t xfer_size,
+                                                   sid_pal_serial_bus_efr32_spi_xfer_done_t done,
+                                                   void *arg);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
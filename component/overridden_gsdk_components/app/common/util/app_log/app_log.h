@@ -53,6 +53,16 @@ extern "C" {
 #define APP_LOG_LEVEL_DEBUG                4
 #define APP_LOG_LEVEL_COUNT                5
 
+// Compile-time log level of the including module. A module can define it
+// before including app_log.h, calls above it are removed by the compiler
+// together with their format strings, the rest is filtered at runtime.
+#ifndef APP_LOG_MODULE_LEVEL
+#define APP_LOG_MODULE_LEVEL               APP_LOG_LEVEL_DEBUG
+#endif
+
+#define _app_log_module_check_level(level) \
+  (((level) <= APP_LOG_MODULE_LEVEL) && app_log_check_level(level))
+
 #define APP_LOG_COUNTER_FORMAT             "%lu"
 #define APP_LOG_TIME_FORMAT                "%lu:%02lu:%02lu.%03lu"
 #define APP_LOG_TRACE_FORMAT               "%s:%d :%s: "
@@ -206,20 +216,20 @@ uint8_t app_log_filter_mask_get(void);
   _ENABLE_FORMAT_ZERO_LENGTH_WARNING
 
 #if defined(SL_SIDEWALK_RTT_PRESENT)
-#define app_log_append_level(level, ...) \
-  do {                                   \
-    if (app_log_check_level(level)) {    \
-      SEGGER_RTT_LOCK();                 \
-      app_log_append(__VA_ARGS__);       \
-      SEGGER_RTT_UNLOCK();               \
-    }                                    \
+#define app_log_append_level(level, ...)      \
+  do {                                        \
+    if (_app_log_module_check_level(level)) { \
+      SEGGER_RTT_LOCK();                      \
+      app_log_append(__VA_ARGS__);            \
+      SEGGER_RTT_UNLOCK();                    \
+    }                                         \
   } while (0)
 #else
-#define app_log_append_level(level, ...) \
-  do {                                   \
-    if (app_log_check_level(level)) {    \
-      app_log_append(__VA_ARGS__);       \
-    }                                    \
+#define app_log_append_level(level, ...)      \
+  do {                                        \
+    if (_app_log_module_check_level(level)) { \
+      app_log_append(__VA_ARGS__);            \
+    }                                         \
   } while (0)
 #endif
 
@@ -342,64 +352,64 @@ uint8_t app_log_filter_mask_get(void);
 #endif
 
 #if defined(SL_SIDEWALK_RTT_PRESENT)
-#define app_log_level(level, ...)      \
-  do {                                 \
-    if (app_log_check_level(level)) {  \
-      SEGGER_RTT_LOCK();               \
-      _app_log_print_color(level);     \
-      _app_log_time();                 \
-      _app_log_counter();              \
-      _app_log_print_prefix(level);    \
-      _app_log_print_trace();          \
-      app_log_append(__VA_ARGS__);     \
-      _app_log_nl_prefix();            \
-      SEGGER_RTT_UNLOCK();             \
-    }                                  \
+#define app_log_level(level, ...)             \
+  do {                                        \
+    if (_app_log_module_check_level(level)) { \
+      SEGGER_RTT_LOCK();                      \
+      _app_log_print_color(level);            \
+      _app_log_time();                        \
+      _app_log_counter();                     \
+      _app_log_print_prefix(level);           \
+      _app_log_print_trace();                 \
+      app_log_append(__VA_ARGS__);            \
+      _app_log_nl_prefix();                   \
+      SEGGER_RTT_UNLOCK();                    \
+    }                                         \
   } while (0)
 #else
-#define app_log_level(level, ...)      \
-  do {                                 \
-    if (app_log_check_level(level)) {  \
-      _app_log_print_color(level);     \
-      _app_log_time();                 \
-      _app_log_counter();              \
-      _app_log_print_prefix(level);    \
-      _app_log_print_trace();          \
-      app_log_append(__VA_ARGS__);     \
-      _app_log_nl_prefix();            \
-    }                                  \
+#define app_log_level(level, ...)             \
+  do {                                        \
+    if (_app_log_module_check_level(level)) { \
+      _app_log_print_color(level);            \
+      _app_log_time();                        \
+      _app_log_counter();                     \
+      _app_log_print_prefix(level);           \
+      _app_log_print_trace();                 \
+      app_log_append(__VA_ARGS__);            \
+      _app_log_nl_prefix();                   \
+    }                                         \
   } while (0)
 #endif
 
 #if defined(SL_SIDEWALK_RTT_PRESENT)
-#define app_log_status_level_f(level, sc, ...)                  \
-  do {                                                          \
-    if (!(sc == SL_STATUS_OK) && app_log_check_level(level)) {  \
-      SEGGER_RTT_LOCK();                                        \
-      _app_log_print_color(level);                              \
-      _app_log_time();                                          \
-      _app_log_counter();                                       \
-      _app_log_print_prefix(level);                             \
-      _app_log_print_trace();                                   \
-      _app_log_print_status(sc);                                \
-      app_log_append(__VA_ARGS__);                              \
-      _app_log_nl_prefix();                                     \
-      SEGGER_RTT_UNLOCK();                                      \
-    }                                                           \
+#define app_log_status_level_f(level, sc, ...)                         \
+  do {                                                                 \
+    if (!(sc == SL_STATUS_OK) && _app_log_module_check_level(level)) { \
+      SEGGER_RTT_LOCK();                                               \
+      _app_log_print_color(level);                                     \
+      _app_log_time();                                                 \
+      _app_log_counter();                                              \
+      _app_log_print_prefix(level);                                    \
+      _app_log_print_trace();                                          \
+      _app_log_print_status(sc);                                       \
+      app_log_append(__VA_ARGS__);                                     \
+      _app_log_nl_prefix();                                            \
+      SEGGER_RTT_UNLOCK();                                             \
+    }                                                                  \
   } while (0)
 #else
-#define app_log_status_level_f(level, sc, ...)                  \
-  do {                                                          \
-    if (!(sc == SL_STATUS_OK) && app_log_check_level(level)) {  \
-      _app_log_print_color(level);                              \
-      _app_log_time();                                          \
-      _app_log_counter();                                       \
-      _app_log_print_prefix(level);                             \
-      _app_log_print_trace();                                   \
-      _app_log_print_status(sc);                                \
-      app_log_append(__VA_ARGS__);                              \
-      _app_log_nl_prefix();                                     \
-    }                                                           \
+#define app_log_status_level_f(level, sc, ...)                         \
+  do {                                                                 \
+    if (!(sc == SL_STATUS_OK) && _app_log_module_check_level(level)) { \
+      _app_log_print_color(level);                                     \
+      _app_log_time();                                                 \
+      _app_log_counter();                                              \
+      _app_log_print_prefix(level);                                    \
+      _app_log_print_trace();                                          \
+      _app_log_print_status(sc);                                       \
+      app_log_append(__VA_ARGS__);                                     \
+      _app_log_nl_prefix();                                            \
+    }                                                                  \
   } while (0)
 #endif
 
@@ -421,7 +431,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_hexdump_level_s(level, separator, p_data, len) \
   do {                                                         \
-    if (app_log_check_level(level)) {                          \
+    if (_app_log_module_check_level(level)) {                  \
       SEGGER_RTT_LOCK();                                       \
       uint8_t *tmp = (uint8_t *)p_data;                        \
       _app_log_print_color(level);                             \
@@ -444,7 +454,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_hexdump_level_s(level, separator, p_data, len) \
   do {                                                         \
-    if (app_log_check_level(level)) {                          \
+    if (_app_log_module_check_level(level)) {                  \
       uint8_t *tmp = (uint8_t *)p_data;                        \
       _app_log_print_color(level);                             \
       _app_log_time();                                         \
@@ -467,7 +477,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_hexdump_reverse_level_s(level, separator, p_data, len) \
   do {                                                                 \
-    if (app_log_check_level(level)) {                                  \
+    if (_app_log_module_check_level(level)) {                          \
       SEGGER_RTT_LOCK();                                               \
       for (uint32_t i = ((uint32_t)len) - 1;; i--) {                   \
         app_log_append(APP_LOG_HEXDUMP_PREFIX);                        \
@@ -485,7 +495,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_hexdump_reverse_level_s(level, separator, p_data, len) \
   do {                                                                 \
-    if (app_log_check_level(level)) {                                  \
+    if (_app_log_module_check_level(level)) {                          \
       for (uint32_t i = ((uint32_t)len) - 1;; i--) {                   \
         app_log_append(APP_LOG_HEXDUMP_PREFIX);                        \
         app_log_append(APP_LOG_HEXDUMP_FORMAT,                         \
@@ -503,7 +513,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_array_dump_level_s(level, separator, p_data, len, format) \
   do {                                                                    \
-    if (app_log_check_level(level)) {                                     \
+    if (_app_log_module_check_level(level)) {                             \
       SEGGER_RTT_LOCK();                                                  \
       for (uint32_t i = 0; i < (uint32_t)len; i++) {                      \
         if (i > 0) {                                                      \
@@ -517,7 +527,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_array_dump_level_s(level, separator, p_data, len, format) \
   do {                                                                    \
-    if (app_log_check_level(level)) {                                     \
+    if (_app_log_module_check_level(level)) {                             \
       for (uint32_t i = 0; i < (uint32_t)len; i++) {                      \
         if (i > 0) {                                                      \
           app_log_append(separator);                                      \
@@ -531,7 +541,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_array_dump_reverse_level_s(level, separator, p_data, len, format) \
   do {                                                                            \
-    if (app_log_check_level(level)) {                                             \
+    if (_app_log_module_check_level(level)) {                                     \
       SEGGER_RTT_LOCK();                                                          \
       for (uint32_t i = 0; i < (uint32_t)len; i++) {                              \
         if (i > 0) {                                                              \
@@ -545,7 +555,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_array_dump_reverse_level_s(level, separator, p_data, len, format) \
   do {                                                                            \
-    if (app_log_check_level(level)) {                                             \
+    if (_app_log_module_check_level(level)) {                                     \
       for (uint32_t i = 0; i < (uint32_t)len; i++) {                              \
         if (i > 0) {                                                              \
           app_log_append(separator);                                              \
@@ -559,7 +569,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_custom_array_dump_level_s(level, separator, array, array_len, array_data_type, iterator_ptr, format, ...) \
   do {                                                                                                                    \
-    if (app_log_check_level(level)) {                                                                                     \
+    if (_app_log_module_check_level(level)) {                                                                             \
       SEGGER_RTT_LOCK();                                                                                                  \
       array_data_type *iterator_ptr = (array_data_type *)array;                                                           \
       for (uint32_t i = 0; i < (uint32_t)array_len; i++) {                                                                \
@@ -575,7 +585,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_custom_array_dump_level_s(level, separator, array, array_len, array_data_type, iterator_ptr, format, ...) \
   do {                                                                                                                    \
-    if (app_log_check_level(level)) {                                                                                     \
+    if (_app_log_module_check_level(level)) {                                                                             \
       array_data_type *iterator_ptr = (array_data_type *)array;                                                           \
       for (uint32_t i = 0; i < (uint32_t)array_len; i++) {                                                                \
         if (i > 0) {                                                                                                      \
@@ -591,7 +601,7 @@ uint8_t app_log_filter_mask_get(void);
 #if defined(SL_SIDEWALK_RTT_PRESENT)
 #define app_log_custom_array_dump_reverse_level_s(level, separator, array, array_len, array_data_type, iterator_ptr, format, ...) \
   do {                                                                                                                            \
-    if (app_log_check_level(level)) {                                                                                             \
+    if (_app_log_module_check_level(level)) {                                                                                     \
       SEGGER_RTT_LOCK();                                                                                                          \
       array_data_type *iterator_ptr = (array_data_type *)(&array + 1) - 1;                                                        \
       for (uint32_t i = 0; i < (uint32_t)array_len; i++) {                                                                        \
@@ -607,7 +617,7 @@ uint8_t app_log_filter_mask_get(void);
 #else
 #define app_log_custom_array_dump_reverse_level_s(level, separator, array, array_len, array_data_type, iterator_ptr, format, ...) \
   do {                                                                                                                            \
-    if (app_log_check_level(level)) {                                                                                             \
+    if (_app_log_module_check_level(level)) {                                                                                     \
       array_data_type *iterator_ptr = (array_data_type *)(&array + 1) - 1;                                                        \
       for (uint32_t i = 0; i < (uint32_t)array_len; i++) {                                                                        \
         if (i > 0) {                                                                                                              \
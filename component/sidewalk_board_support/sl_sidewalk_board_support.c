@@ -64,6 +64,11 @@
 #include "em_cmu.h"
 #endif
 
+#if defined(SL_SIDEWALK_SENSOR)
+#include "sl_sidewalk_sensor.h"
+#include "sl_sidewalk_sensor_config.h"
+#endif
+
 #include "sl_sidewalk_board_support.h"
 #include "app_assert.h"
 
@@ -157,8 +162,8 @@ static void HN_temperature_timer_cb(TimerHandle_t pxTimer)
   (void) pxTimer;
   int32_t temp_data;
   static bool isPrevTempData = false;
-  char number_buffer[8];
-  memset(number_buffer, 0, sizeof(number_buffer));
+  // Temperature in 0.01 degC as expected by the sensor report
+  int32_t temp_centi_degc;
 
 #if defined(SL_TEMPERATURE_SENSOR_EXTERNAL)
   uint32_t rh_data;
@@ -167,14 +172,29 @@ static void HN_temperature_timer_cb(TimerHandle_t pxTimer)
                                 SI7021_ADDR,
                                 &rh_data,
                                 &temp_data);
-  sprintf(number_buffer, "%.2f", (float)((float)temp_data / 1000.0));
+  temp_centi_degc = temp_data / 10;
 #elif defined(SL_TEMPERATURE_SENSOR_INTERNAL)
   temp_data = (int32_t)TEMPDRV_GetTemp();
-  sprintf(number_buffer, "%d", temp_data);
+  temp_centi_degc = temp_data * 100;
 #endif
 
 #if defined(SL_SIDEWALK_SENSOR)
-  sl_sidewalk_sensor_report(SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE, number_buffer, SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW);
+#if defined(SL_TEMPERATURE_SENSOR_INTERNAL) && !SL_SIDEWALK_SENSOR_BINARY_REPORT
+  // TEMPDRV has a 1 degC resolution, keep the integer text report unless the
+  // temperature goes to the aggregation
+  if (!SL_SIDEWALK_SENSOR_AGGREGATION
+      || ((SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK & (1UL << SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE)) == 0)) {
+    char number_buffer[12];
+    snprintf(number_buffer, sizeof(number_buffer), "%ld", (long)temp_data);
+    sl_sidewalk_sensor_report(SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE, number_buffer, SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW);
+  } else {
+    sl_sidewalk_sensor_report_int(SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE, temp_centi_degc, SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW);
+  }
+#else
+  sl_sidewalk_sensor_report_int(SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE, temp_centi_degc, SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW);
+#endif
+#else
+  (void)temp_centi_degc;
 #endif
 
 #if defined(SL_SEGMENT_LCD)
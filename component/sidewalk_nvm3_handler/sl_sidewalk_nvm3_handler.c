@@ -84,6 +84,8 @@ void sl_sidewalk_nvm3_handler_init(void)
   if (nvm3_open(nvm3_defaultHandle, nvm3_defaultInit) != ECODE_NVM3_OK) {
     app_log_warning("NVM3 init failed");
   }
+
+  sli_sid_nvm3_repack_init();
 }
 
 /*******************************************************************************
@@ -106,12 +108,10 @@ int32_t sl_sidewalk_nvm3_write(uint32_t value,
     return SL_SIDEWALK_NVM3_DATA_WRITE_FAILED;
   }
 
-  // Do repacking if needed
-  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-    status = nvm3_repack(nvm3_defaultHandle);
-    if (status != ECODE_NVM3_OK) {
-      return SL_SIDEWALK_NVM3_DATA_REPACK_FAILED;
-    }
+  // Do repacking if needed, deferred to the repack task when possible
+  status = sli_sid_nvm3_repack_request();
+  if (status != ECODE_NVM3_OK) {
+    return SL_SIDEWALK_NVM3_DATA_REPACK_FAILED;
   }
 
   return 0;
@@ -36,16 +36,339 @@
 #define SL_SIDEWALK_PAL_SWI_IMPL_METHOD_SWI_INTERRUPT   1
 #define SL_SIDEWALK_PAL_SWI_IMPL_METHOD_RTOS_THREAD     2
 
+#define SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BITWISE          0
+#define SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE     1
+#define SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BYTE_TABLE       2
+#define SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC            3
+
 // <h> Sidewalk PAL configuration
 // <o SL_SIDEWALK_PAL_SWI_IMPL_METHOD> SWI implementation method
 // <SL_SIDEWALK_PAL_SWI_IMPL_METHOD_SWI_INTERRUPT=> SWI interrupt
 // <SL_SIDEWALK_PAL_SWI_IMPL_METHOD_RTOS_THREAD=> RTOS thread
-// <i> Default: SL_SIDEWALK_PAL_SWI_IMPL_METHOD_RTOS_THREAD
+// <i> Context the stack runs in. With the RTOS thread, carrier sense and
+// <i> noise measurements of the EFR32 radio sleep until the radio reports
+// <i> the result. With the SWI interrupt they cannot block and poll the
+// <i> RSSI for the whole window.
+// <i> Default: SL_SIDEWALK_PAL_SWI_IMPL_METHOD_SWI_INTERRUPT
 #ifndef SL_SIDEWALK_PAL_SWI_IMPL_METHOD
 #define SL_SIDEWALK_PAL_SWI_IMPL_METHOD SL_SIDEWALK_PAL_SWI_IMPL_METHOD_SWI_INTERRUPT
 #endif
 // </h>
 
+// <h> Sidewalk PAL key-value storage configuration
+// <o SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM> Number of cached record directories <0-32>
+// <i> Number of KV groups whose record layout (key, offset, length) is kept
+// <i> in RAM, so record lookups do not scan the group object in flash.
+// <i> 0 disables the directory cache.
+// <i> Default: 8
+#ifndef SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM
+#define SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM 8
+#endif
+
+// <o SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM> Maximum number of records per cached directory <1-64>
+// <i> Groups holding more records are looked up in flash.
+// <i> Default: 16
+#ifndef SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM
+#define SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM 16
+#endif
+
+// <e SL_SIDEWALK_PAL_KV_CACHE> Write-back cache of frequently written groups
+// <i> The groups listed in SL_SIDEWALK_PAL_KV_CACHE_GROUPS are kept in RAM and
+// <i> reads are served from there. Changed records are appended to a journal
+// <i> object on a flush, which is folded into the group objects when full and
+// <i> replayed on init, so a reset falls back to the last flushed values.
+// <i> Call sli_sid_storage_kv_flush() before a planned reset. Changes since
+// <i> the last flush are lost on a brown-out or an unplanned reset.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_KV_CACHE
+#define SL_SIDEWALK_PAL_KV_CACHE 0
+#endif
+
+// <i> Initializer list of the cached group IDs
+#ifndef SL_SIDEWALK_PAL_KV_CACHE_GROUPS
+#define SL_SIDEWALK_PAL_KV_CACHE_GROUPS { SID_PAL_STORAGE_KV_INTERNAL_PROTOCOL_GROUP_ID }
+#endif
+
+// <o SL_SIDEWALK_PAL_KV_CACHE_FLUSH_INTERVAL_MS> Flush interval [ms]
+// <i> Longest time a changed record stays in RAM only
+// <i> Default: 30000
+#ifndef SL_SIDEWALK_PAL_KV_CACHE_FLUSH_INTERVAL_MS
+#define SL_SIDEWALK_PAL_KV_CACHE_FLUSH_INTERVAL_MS 30000
+#endif
+
+// <o SL_SIDEWALK_PAL_KV_CACHE_DIRTY_RECORD_NUM> Changed records per group between flushes <1-32>
+// <i> One more changed record flushes the group early
+// <i> Default: 8
+#ifndef SL_SIDEWALK_PAL_KV_CACHE_DIRTY_RECORD_NUM
+#define SL_SIDEWALK_PAL_KV_CACHE_DIRTY_RECORD_NUM 8
+#endif
+
+// <o SL_SIDEWALK_PAL_KV_JOURNAL_SIZE> Journal size [bytes] <64-1024>
+// <i> Default: 256
+#ifndef SL_SIDEWALK_PAL_KV_JOURNAL_SIZE
+#define SL_SIDEWALK_PAL_KV_JOURNAL_SIZE 256
+#endif
+// </e>
+// </h>
+
+// <h> Sidewalk PAL timer configuration
+// <o SL_SIDEWALK_PAL_TIMER_HEAP_SIZE> Maximum number of armed timers per priority class <4-255>
+// <i> All sid_pal timers are served by a single sleeptimer
+// <i> Default: 32
+#ifndef SL_SIDEWALK_PAL_TIMER_HEAP_SIZE
+#define SL_SIDEWALK_PAL_TIMER_HEAP_SIZE 32
+#endif
+
+// <o SL_SIDEWALK_PAL_TIMER_LOWPOWER_SLACK_MS> LOWPOWER timer slack [ms] <0-1000>
+// <i> LOWPOWER class timers may expire this much late, so timers expiring
+// <i> close to each other share a single wakeup
+// <i> Default: 5
+#ifndef SL_SIDEWALK_PAL_TIMER_LOWPOWER_SLACK_MS
+#define SL_SIDEWALK_PAL_TIMER_LOWPOWER_SLACK_MS 5
+#endif
+// </h>
+
+// <h> Sidewalk PAL NVM3 repack configuration
+// <q SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK> Deferred repack
+// <i> If enabled, NVM3 repacks requested after writes of the KV store, the
+// <i> manufacturing store and the NVM3 handler run in a low priority task
+// <i> instead of the context of the write. Projects without the FreeRTOS
+// <i> kernel repack inline.
+// <i> Default: 1
+#ifndef SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK
+#define SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK 1
+#endif
+
+// <o SL_SIDEWALK_PAL_NVM3_REPACK_DEADLINE_MS> Repack deadline [ms]
+// <i> A repack pending longer than this is done by the next write inline.
+// <i> Default: 10000
+#ifndef SL_SIDEWALK_PAL_NVM3_REPACK_DEADLINE_MS
+#define SL_SIDEWALK_PAL_NVM3_REPACK_DEADLINE_MS 10000
+#endif
+
+// <o SL_SIDEWALK_PAL_NVM3_REPACK_TASK_PRIORITY> Repack task priority
+// <i> Default: 1
+#ifndef SL_SIDEWALK_PAL_NVM3_REPACK_TASK_PRIORITY
+#define SL_SIDEWALK_PAL_NVM3_REPACK_TASK_PRIORITY 1
+#endif
+
+// <o SL_SIDEWALK_PAL_NVM3_REPACK_TASK_STACK_SIZE> Repack task stack size [bytes]
+// <i> Default: 512
+#ifndef SL_SIDEWALK_PAL_NVM3_REPACK_TASK_STACK_SIZE
+#define SL_SIDEWALK_PAL_NVM3_REPACK_TASK_STACK_SIZE 512
+#endif
+// </h>
+
+// <h> Sidewalk PAL crypto configuration
+// <o SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE> Imported key cache entries <0-8>
+// <i> AES, AEAD and HMAC keys stay imported into PSA between operations and
+// <i> are reused while the stack keeps using the same key. Every entry holds a
+// <i> PSA key slot, the cache gives them back when the key store runs out.
+// <i> 0 imports and destroys the key on every operation.
+// <i> Default: 3
+#ifndef SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE 3
+#endif
+
+// <o SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE> Largest cached key [bytes] <16-64:4>
+// <i> Longer keys are not cached
+// <i> Default: 32
+#ifndef SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE 32
+#endif
+
+// <e SL_SIDEWALK_PAL_CRYPTO_ECC_POOL> Pre-generated ECDH key pairs
+// <i> A low priority task keeps a pool of P-256 and X25519 key pairs filled,
+// <i> sid_pal_crypto_ecc_key_gen() hands them out instead of generating a
+// <i> key pair on the spot, e.g. during the secure session setup.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+#define SL_SIDEWALK_PAL_CRYPTO_ECC_POOL 0
+#endif
+
+// <o SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_SIZE> Key pairs per curve <1-8>
+// <i> Default: 2
+#ifndef SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_SIZE 2
+#endif
+
+// <o SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_PRIORITY> Refill task priority
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_PRIORITY
+#define SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_PRIORITY 0
+#endif
+
+// <o SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_STACK_SIZE> Refill task stack size [bytes]
+// <i> Default: 2048
+#ifndef SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_STACK_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_STACK_SIZE 2048
+#endif
+// </e>
+// </h>
+
+// <h> Sidewalk PAL radio configuration
+// <o SL_SIDEWALK_PAL_RADIO_CRC_IMPL> FSK CRC16/CRC32 implementation
+// <SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BITWISE=> Bitwise, no table
+// <SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE=> 16 entry tables (96 bytes of flash)
+// <SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BYTE_TABLE=> 256 entry tables (1.5 kB of flash)
+// <SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC=> GPCRC peripheral
+// <i> CRC of the FSK frames of the EFR32 radio. Larger tables are faster.
+// <i> The GPCRC peripheral needs the emlib_gpcrc component in the project.
+// <i> Default: SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE
+#ifndef SL_SIDEWALK_PAL_RADIO_CRC_IMPL
+#define SL_SIDEWALK_PAL_RADIO_CRC_IMPL SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE
+#endif
+
+// <o SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE> Channels of the noise table <0-64>
+// <i> Noise floor and occupancy per channel, fed by noise measurements,
+// <i> carrier sense results and the RSSI of empty receive windows.
+// <i> 0 disables the table.
+// <i> Default: 16
+#ifndef SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE
+#define SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE 16
+#endif
+
+// <o SL_SIDEWALK_PAL_RADIO_NOISE_MAX_AGE_MS> Noise floor maximum age [ms]
+// <i> sid_pal_radio_get_chan_noise() returns the noise floor of the table
+// <i> instead of measuring it while it is not older than this.
+// <i> 0 measures on every call.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_RADIO_NOISE_MAX_AGE_MS
+#define SL_SIDEWALK_PAL_RADIO_NOISE_MAX_AGE_MS 0
+#endif
+// </h>
+
+// <h> Sidewalk PAL log configuration
+// <o SL_SIDEWALK_PAL_LOG_RECORD_MAX_SIZE> Binary record maximum size [bytes] <32-252:4>
+// <i> Size of the records of the deferred log and the crash log. Arguments
+// <i> not fitting the record are dropped, the record is marked truncated.
+// <i> Default: 128
+#ifndef SL_SIDEWALK_PAL_LOG_RECORD_MAX_SIZE
+#define SL_SIDEWALK_PAL_LOG_RECORD_MAX_SIZE 128
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_STRING_MAX_LEN> Binary record string argument maximum length [bytes] <0-240>
+// <i> Default: 32
+#ifndef SL_SIDEWALK_PAL_LOG_STRING_MAX_LEN
+#define SL_SIDEWALK_PAL_LOG_STRING_MAX_LEN 32
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_LEVEL_TIMER> Compile-time log level of the timer
+// <0=> Error
+// <1=> Warning
+// <2=> Info
+// <3=> Debug
+// <i> Logs above this level are removed from the build with their strings
+// <i> Default: 3
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_TIMER
+#define SL_SIDEWALK_PAL_LOG_LEVEL_TIMER 3
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_LEVEL_RADIO> Compile-time log level of the sub-GHz radio
+// <0=> Error
+// <1=> Warning
+// <2=> Info
+// <3=> Debug
+// <i> Default: 3
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_RADIO
+#define SL_SIDEWALK_PAL_LOG_LEVEL_RADIO 3
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_LEVEL_BLE> Compile-time log level of the BLE adapter
+// <0=> Error
+// <1=> Warning
+// <2=> Info
+// <3=> Debug
+// <i> Default: 3
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_BLE
+#define SL_SIDEWALK_PAL_LOG_LEVEL_BLE 3
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE> Compile-time log level of the storage (key-value, manufacturing store, NVM3)
+// <0=> Error
+// <1=> Warning
+// <2=> Info
+// <3=> Debug
+// <i> Default: 3
+#ifndef SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE
+#define SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE 3
+#endif
+
+// <e SL_SIDEWALK_PAL_LOG_DEFERRED> Deferred binary log
+// <i> If enabled, sid_pal_log() stores the format string address, a timestamp
+// <i> and the raw arguments in a RAM ring instead of formatting the line. The
+// <i> records are printed as hex lines and decoded on the host with the ELF
+// <i> file by tools/scripts/public/sid_log_decoder.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_LOG_DEFERRED
+#define SL_SIDEWALK_PAL_LOG_DEFERRED 0
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_RING_SIZE> Ring size [bytes] <256-16384:4>
+// <i> Records not fitting the ring are dropped
+// <i> Default: 2048
+#ifndef SL_SIDEWALK_PAL_LOG_RING_SIZE
+#define SL_SIDEWALK_PAL_LOG_RING_SIZE 2048
+#endif
+
+// <q SL_SIDEWALK_PAL_LOG_DRAIN_TASK> Drain task
+// <i> If enabled, a task prints the records. If disabled, the records are only
+// <i> read by sid_pal_log_get_log_buffer() and sid_pal_log_flush().
+// <i> Default: 1
+#ifndef SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+#define SL_SIDEWALK_PAL_LOG_DRAIN_TASK 1
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_DRAIN_TASK_PRIORITY> Drain task priority
+// <i> The records are printed when no other task is ready at the default idle priority
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_LOG_DRAIN_TASK_PRIORITY
+#define SL_SIDEWALK_PAL_LOG_DRAIN_TASK_PRIORITY 0
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_DRAIN_TASK_STACK_SIZE> Drain task stack size [bytes]
+// <i> Default: 768
+#ifndef SL_SIDEWALK_PAL_LOG_DRAIN_TASK_STACK_SIZE
+#define SL_SIDEWALK_PAL_LOG_DRAIN_TASK_STACK_SIZE 768
+#endif
+// </e>
+
+// <e SL_SIDEWALK_PAL_LOG_CRASH_RING> Crash log ring
+// <i> If enabled, the latest log records are also kept in RAM not initialized
+// <i> at reset. After a soft reset, e.g. by the watchdog after an assert, the
+// <i> records of the previous run can be printed, or read one by one with
+// <i> sid_pal_log_get_log_buffer() when the deferred log is disabled.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_PAL_LOG_CRASH_RING
+#define SL_SIDEWALK_PAL_LOG_CRASH_RING 0
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_CRASH_RING_SIZE> Ring size [bytes] <256-4096:4>
+// <i> Two rings are allocated, for the current and the previous run
+// <i> Default: 1024
+#ifndef SL_SIDEWALK_PAL_LOG_CRASH_RING_SIZE
+#define SL_SIDEWALK_PAL_LOG_CRASH_RING_SIZE 1024
+#endif
+
+// <o SL_SIDEWALK_PAL_LOG_CRASH_RING_LEVEL> Lowest severity kept
+// <0=> Error
+// <1=> Warning
+// <2=> Info
+// <3=> Debug
+// <i> Default: 2
+#ifndef SL_SIDEWALK_PAL_LOG_CRASH_RING_LEVEL
+#define SL_SIDEWALK_PAL_LOG_CRASH_RING_LEVEL 2
+#endif
+
+// <s SL_SIDEWALK_PAL_LOG_CRASH_RING_SECTION> Linker section
+// <i> Has to be a section not initialized by the startup code
+// <i> Default: ".noinit"
+#ifndef SL_SIDEWALK_PAL_LOG_CRASH_RING_SECTION
+#define SL_SIDEWALK_PAL_LOG_CRASH_RING_SECTION ".noinit"
+#endif
+// </e>
+// </h>
+
 // <<< end of configuration section >>>
 
 #endif // SL_SIDEWALK_PAL_CONFIG_H
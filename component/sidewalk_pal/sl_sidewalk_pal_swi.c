@@ -43,6 +43,7 @@
 #include <sid_pal_swi_ifc.h>
 #include <sid_pal_log_ifc.h>
 #include "sl_sidewalk_pal_config.h"
+#include "timer_stats.h"
 #if (SL_SIDEWALK_PAL_SWI_IMPL_METHOD == SL_SIDEWALK_PAL_SWI_IMPL_METHOD_RTOS_THREAD)
 #include <FreeRTOS.h>
 #include <task.h>
@@ -93,6 +94,8 @@ static void swi_thread(void *context)
       if (swi_callback != NULL) {
         swi_callback();
       }
+      // Awake anyway, serve the LOWPOWER timers waiting within their slack
+      sli_sid_pal_timer_align_wakeup();
     }
   }
 
@@ -106,6 +109,8 @@ void SW3_IRQHandler(void)
   if (swi_callback != NULL) {
     swi_callback();
   }
+  // Awake anyway, serve the LOWPOWER timers waiting within their slack
+  sli_sid_pal_timer_align_wakeup();
 }
 #endif // SL_SIDEWALK_PAL_SWI_IMPL_METHOD_RTOS_THREAD
 
@@ -43,9 +43,11 @@
 #include <stdint.h>
 #include <string.h>
 
+// Compile-time log level of the sender, it has to precede app_log.h
+#define APP_LOG_MODULE_LEVEL SL_SIDEWALK_SENDER_LOG_LEVEL
 #include "app_log.h"
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "semphr.h"
 #include "sl_sidewalk_sender.h"
 #include "sl_sidewalk_utils.h"
 #include "sl_sidewalk_utils_config.h"
@@ -54,21 +56,42 @@
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
-#define SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES (255)
+// Every priority can hold the same amount of pending messages as before, the
+// slots are shared from one pool
+#define SIDEWALK_SENDER_SLOT_NUM (SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM * SL_SIDEWALK_SENDER_TYPE_END)
+
+typedef enum {
+  SIDEWALK_SENDER_SLOT_FREE = 0,
+  SIDEWALK_SENDER_SLOT_QUEUED,
+  SIDEWALK_SENDER_SLOT_SENDING,
+  SIDEWALK_SENDER_SLOT_IN_FLIGHT
+} sidewalk_sender_slot_state_t;
 
 typedef struct {
-  char msg[SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES];
+  uint8_t msg[SL_SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES];
   size_t len;
   uint16_t id;
   sid_error_t error;
   TickType_t last_try;
+  sidewalk_sender_slot_state_t state;
 } sidewalk_sender_msg_t;
 
+// FIFO of slot indexes belonging to one priority
+typedef struct {
+  uint8_t slot_ix[SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM];
+  uint8_t head;
+  uint8_t count;
+} sidewalk_sender_ring_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
-static uint16_t put_message(struct sid_handle *sidewalk_handle, char* payload, uint16_t payload_length);
+static sid_error_t put_message(struct sid_handle *sidewalk_handle, uint8_t *payload, uint16_t payload_length, uint16_t *id);
+static uint8_t ring_slot_get(const sidewalk_sender_ring_t *ring, uint8_t position);
+static void ring_remove(sidewalk_sender_ring_t *ring, uint8_t position);
+static bool select_message(uint8_t *slot_ix, int8_t *priority);
+static void release_slot(uint8_t slot_ix);
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -78,7 +101,11 @@ static uint16_t put_message(struct sid_handle *sidewalk_handle, char* payload, u
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
-static QueueHandle_t sender_queues[SL_SIDEWALK_SENDER_TYPE_END];
+static sidewalk_sender_msg_t sender_slots[SIDEWALK_SENDER_SLOT_NUM];
+static sidewalk_sender_ring_t sender_rings[SL_SIDEWALK_SENDER_TYPE_END];
+static uint8_t free_slots[SIDEWALK_SENDER_SLOT_NUM];
+static uint8_t free_slots_count = 0;
+static SemaphoreHandle_t sender_lock = NULL;
 
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
@@ -86,101 +113,201 @@ static QueueHandle_t sender_queues[SL_SIDEWALK_SENDER_TYPE_END];
 
 void sl_sidewalk_sender_init(void)
 {
-  for (uint8_t queue_ix = 0; queue_ix < SL_SIDEWALK_SENDER_TYPE_END; queue_ix++) {
-    sender_queues[queue_ix] = xQueueCreate(SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM, sizeof(sidewalk_sender_msg_t));
+  memset(sender_slots, 0, sizeof(sender_slots));
+  memset(sender_rings, 0, sizeof(sender_rings));
+
+  for (uint8_t slot_ix = 0; slot_ix < SIDEWALK_SENDER_SLOT_NUM; slot_ix++) {
+    free_slots[slot_ix] = slot_ix;
   }
+  free_slots_count = SIDEWALK_SENDER_SLOT_NUM;
+
+  sender_lock = xSemaphoreCreateMutex();
 }
 
 void sl_sidewalk_sender_send(struct sid_handle *sidewalk_handle)
 {
-  static sidewalk_sender_msg_t message_to_send;
-  static TickType_t current_time;
+  uint8_t slot_ix;
+  int8_t priority;
 
-  // for(uint8_t queue_ix = SL_SIDEWALK_SENDER_TYPE_PRIORITY_HIGH; queue_ix >= 0 ; queue_ix--)
-  for (int8_t queue_ix = SL_SIDEWALK_SENDER_TYPE_PRIORITY_HIGH; queue_ix >= 0; queue_ix--) {
-    if (xQueueReceive(sender_queues[queue_ix], &message_to_send, 0) == pdTRUE) {
-      current_time = xTaskGetTickCount();
-
-      if (message_to_send.last_try == 0) {
-        app_log_info("###############################");
-        app_log_info("            FIRST TRY          ");
-        app_log_info("            PRIO: %d           ", queue_ix);
-        app_log_info("###############################");
-        message_to_send.id = put_message(sidewalk_handle, message_to_send.msg, message_to_send.len);
-        message_to_send.last_try = xTaskGetTickCount();
-      } else {
-        if (current_time - message_to_send.last_try >= pdMS_TO_TICKS(SL_SIDEWALK_UTILS_MSG_TIMEOUT_MS)) {
-          app_log_info("###############################");
-          app_log_info("              RETRY            ");
-          app_log_info("            PRIO: %d           ", queue_ix);
-          app_log_info("###############################");
-          message_to_send.id = put_message(sidewalk_handle, message_to_send.msg, message_to_send.len);
-          message_to_send.last_try = xTaskGetTickCount();
-        }
-      }
+  xSemaphoreTake(sender_lock, portMAX_DELAY);
+  bool selected = select_message(&slot_ix, &priority);
+  if (selected) {
+    // Claim the slot before releasing the lock so neither a concurrent send
+    // nor a late acknowledgement of a previous try can touch it
+    sender_slots[slot_ix].state = SIDEWALK_SENDER_SLOT_SENDING;
+  }
+  xSemaphoreGive(sender_lock);
 
-      xQueueSendToFront(sender_queues[queue_ix], &message_to_send, (TickType_t)0);
-      break;
-    }
+  if (!selected) {
+    return;
   }
+
+  sidewalk_sender_msg_t *message_to_send = &sender_slots[slot_ix];
+
+  app_log_info("###############################");
+  app_log_info("%s", (message_to_send->last_try == 0) ? "            FIRST TRY          " : "              RETRY            ");
+  app_log_info("            PRIO: %d           ", priority);
+  app_log_info("###############################");
+
+  uint16_t id = 0;
+  sid_error_t ret = put_message(sidewalk_handle, message_to_send->msg, message_to_send->len, &id);
+
+  xSemaphoreTake(sender_lock, portMAX_DELAY);
+  message_to_send->id = id;
+  message_to_send->last_try = xTaskGetTickCount();
+  // A message that could not be handed over to the stack cannot be
+  // acknowledged, it waits for the retry timeout instead
+  message_to_send->state = (ret == SID_ERROR_NONE) ? SIDEWALK_SENDER_SLOT_IN_FLIGHT : SIDEWALK_SENDER_SLOT_QUEUED;
+  xSemaphoreGive(sender_lock);
 }
 
 void sl_sidewalk_sender_sent_handler(uint16_t id, sid_error_t error)
 {
-  sidewalk_sender_msg_t message;
+  xSemaphoreTake(sender_lock, portMAX_DELAY);
 
   for (uint8_t queue_ix = 0; queue_ix < SL_SIDEWALK_SENDER_TYPE_END; queue_ix++) {
-    if (pdTRUE == xQueuePeek(sender_queues[queue_ix], &message, (TickType_t)0)) {
-      if (message.id == id) {
+    sidewalk_sender_ring_t *ring = &sender_rings[queue_ix];
+
+    for (uint8_t position = 0; position < ring->count; position++) {
+      uint8_t slot_ix = ring_slot_get(ring, position);
+      sidewalk_sender_msg_t *message = &sender_slots[slot_ix];
+
+      if ((message->state == SIDEWALK_SENDER_SLOT_IN_FLIGHT) && (message->id == id)) {
         if (error == SID_ERROR_NONE) {
           // Remove from the queue, sent successfully
-          xQueueReceive(sender_queues[queue_ix], &message, (TickType_t)100);
+          ring_remove(ring, position);
+          release_slot(slot_ix);
         } else {
-          if (pdTRUE == xQueueReceive(sender_queues[queue_ix], &message, (TickType_t)100)) {
-            message.error = error;
-            message.last_try = 0;
-            xQueueSendToFront(sender_queues[queue_ix], &message, (TickType_t)100);
-          }
+          // Retry on the next send call
+          message->error = error;
+          message->last_try = 0;
+          message->state = SIDEWALK_SENDER_SLOT_QUEUED;
         }
-        break;
+        xSemaphoreGive(sender_lock);
+        return;
       }
     }
   }
+
+  xSemaphoreGive(sender_lock);
 }
 
-bool sl_sidewalk_sender_queue_message(char *message, size_t message_length, sl_sidewalk_sender_priority_type_t priority)
+bool sl_sidewalk_sender_queue_message(const uint8_t *message, size_t message_length, sl_sidewalk_sender_priority_type_t priority)
 {
-  sidewalk_sender_msg_t message_to_send;
-  memset((void*) &message_to_send, 0, sizeof(message_to_send));
+  bool result = false;
 
-  strcpy(message_to_send.msg, message);
-  message_to_send.len = message_length;
-  message_to_send.last_try = 0;
+  if ((message == NULL)
+      || (message_length == 0)
+      || (message_length > SL_SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES)
+      || ((uint32_t)priority >= SL_SIDEWALK_SENDER_TYPE_END)) {
+    return false;
+  }
+
+  xSemaphoreTake(sender_lock, portMAX_DELAY);
+
+  sidewalk_sender_ring_t *ring = &sender_rings[priority];
+  if ((ring->count < SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM) && (free_slots_count > 0)) {
+    uint8_t slot_ix = free_slots[--free_slots_count];
+    sidewalk_sender_msg_t *message_to_send = &sender_slots[slot_ix];
+    memset((void*) message_to_send, 0, sizeof(*message_to_send));
+
+    memcpy(message_to_send->msg, message, message_length);
+    message_to_send->len = message_length;
+    message_to_send->last_try = 0;
+    message_to_send->state = SIDEWALK_SENDER_SLOT_QUEUED;
 
-  if (pdTRUE == xQueueSend(sender_queues[priority], (void*) &message_to_send, (TickType_t)0)) {
-    return true;
+    ring->slot_ix[(ring->head + ring->count) % SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM] = slot_ix;
+    ring->count++;
+    result = true;
   }
 
-  return false;
+  xSemaphoreGive(sender_lock);
+
+  return result;
 }
 
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
-static uint16_t put_message(struct sid_handle *sidewalk_handle, char *payload, uint16_t payload_length)
+static uint8_t ring_slot_get(const sidewalk_sender_ring_t *ring, uint8_t position)
+{
+  return ring->slot_ix[(ring->head + position) % SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM];
+}
+
+static void ring_remove(sidewalk_sender_ring_t *ring, uint8_t position)
+{
+  // Close the gap by moving the younger entries one step towards the head,
+  // only slot indexes are moved, never the messages themselves
+  for (uint8_t ix = position; (ix + 1) < ring->count; ix++) {
+    ring->slot_ix[(ring->head + ix) % SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM] =
+      ring->slot_ix[(ring->head + ix + 1) % SL_SIDEWALK_UTILS_MAX_PENDING_MESSAGES_NUM];
+  }
+  ring->count--;
+  if (ring->count == 0) {
+    ring->head = 0;
+  }
+}
+
+static bool select_message(uint8_t *slot_ix, int8_t *priority)
+{
+  TickType_t current_time = xTaskGetTickCount();
+
+  for (int8_t queue_ix = SL_SIDEWALK_SENDER_TYPE_PRIORITY_HIGH; queue_ix >= 0; queue_ix--) {
+    sidewalk_sender_ring_t *ring = &sender_rings[queue_ix];
+    uint8_t in_flight = 0;
+
+    for (uint8_t position = 0; position < ring->count; position++) {
+      if (sender_slots[ring_slot_get(ring, position)].state >= SIDEWALK_SENDER_SLOT_SENDING) {
+        in_flight++;
+      }
+    }
+
+    for (uint8_t position = 0; position < ring->count; position++) {
+      uint8_t candidate_ix = ring_slot_get(ring, position);
+      sidewalk_sender_msg_t *message = &sender_slots[candidate_ix];
+      bool due = false;
+
+      if (message->state == SIDEWALK_SENDER_SLOT_SENDING) {
+        continue;
+      } else if (message->last_try == 0) {
+        // New messages respect the in-flight limit of their priority
+        due = (message->state == SIDEWALK_SENDER_SLOT_QUEUED)
+              && (in_flight < SL_SIDEWALK_UTILS_MAX_IN_FLIGHT_MESSAGES_NUM);
+      } else {
+        due = (current_time - message->last_try >= pdMS_TO_TICKS(SL_SIDEWALK_UTILS_MSG_TIMEOUT_MS));
+      }
+
+      if (due) {
+        *slot_ix = candidate_ix;
+        *priority = queue_ix;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+static void release_slot(uint8_t slot_ix)
+{
+  sender_slots[slot_ix].state = SIDEWALK_SENDER_SLOT_FREE;
+  free_slots[free_slots_count++] = slot_ix;
+}
+
+static sid_error_t put_message(struct sid_handle *sidewalk_handle, uint8_t *payload, uint16_t payload_length, uint16_t *id)
 {
   app_log_info("###############################");
   app_log_info("        SENDING MESSAGE        ");
   app_log_info("###############################");
   app_log_info("sending %d bytes", payload_length);
-  app_log_info("sending %s", payload);
+  app_log_hexdump_info(payload, payload_length);
   app_log_info("###############################");
   app_log_info("###############################");
 
   struct sid_msg msg = {
     .data = payload,
-    .size = strlen(payload)
+    .size = payload_length
   };
 
   // The descriptor is cleared and then only partially initialized which is
@@ -199,5 +326,6 @@ static uint16_t put_message(struct sid_handle *sidewalk_handle, char *payload, u
     app_log_info("queued data msg id: %u", desc.id);
   }
 
-  return desc.id;
+  *id = desc.id;
+  return ret;
 }
@@ -43,6 +43,8 @@
 // -----------------------------------------------------------------------------
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "sid_api.h"
 #include "sid_error.h"
@@ -50,6 +52,9 @@
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+
+#define SL_SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES (255)
+
 typedef enum {
   SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW = 0,
   SL_SIDEWALK_SENDER_TYPE_PRIORITY_MEDIUM,
@@ -71,6 +76,16 @@ void sl_sidewalk_sender_init(void);
 
 void sl_sidewalk_sender_send(struct sid_handle *sidewalk_handle);
 void sl_sidewalk_sender_sent_handler(uint16_t id, sid_error_t error);
-bool sl_sidewalk_sender_queue_message(char *message, size_t message_length, sl_sidewalk_sender_priority_type_t priority);
+
+/**************************************************************************//**
+ * Queue a message to be sent to the cloud. The payload is handled as raw
+ * bytes, exactly message_length bytes are copied and sent.
+ *
+ * @param message Payload to be sent
+ * @param message_length Length of the payload in bytes (1-255)
+ * @param priority Priority of the message
+ * @return true if the message is queued, false otherwise
+ *****************************************************************************/
+bool sl_sidewalk_sender_queue_message(const uint8_t *message, size_t message_length, sl_sidewalk_sender_priority_type_t priority);
 
 #endif // SL_SIDEWALK_MESSAGE_SENDER_H
@@ -0,0 +1,119 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sidewalk sensor component configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_SENSOR_CONFIG_H
+#define SL_SIDEWALK_SENSOR_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Sidewalk sensor report configuration
+
+// <q SL_SIDEWALK_SENSOR_BINARY_REPORT> Binary report format
+// <i> If enabled, sensor values are reported in the packed binary format
+// <i> (see sl_sidewalk_sensor_encode()) instead of the ":name=value" text
+// <i> format. The cloud application must decode the selected format.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_SENSOR_BINARY_REPORT
+#define SL_SIDEWALK_SENSOR_BINARY_REPORT 0
+#endif
+
+// </h>
+
+// <h> Sidewalk sensor aggregation configuration
+
+// <q SL_SIDEWALK_SENSOR_AGGREGATION> Sensor report aggregation
+// <i> If enabled, integer values of the sensors selected by
+// <i> SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK are collected over a window
+// <i> and sent as one binary report. Requires the binary report format.
+// <i> Default: 0
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION
+#define SL_SIDEWALK_SENSOR_AGGREGATION 0
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK> Aggregated sensors
+// <i> Bit mask of sl_sidewalk_sensor_type_t values to be aggregated
+// <i> Default: 0x04 (temperature)
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK
+#define SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK 0x04
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_MAX_SAMPLES> Maximum samples per sensor and window <1-255>
+// <i> Default: 30
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_MAX_SAMPLES
+#define SL_SIDEWALK_SENSOR_AGGREGATION_MAX_SAMPLES 30
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_BLE_WINDOW_MS> Window on the BLE link [ms]
+// <i> Default: 10000
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_BLE_WINDOW_MS
+#define SL_SIDEWALK_SENSOR_AGGREGATION_BLE_WINDOW_MS 10000
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_BLE_CONTENT> Report content on the BLE link
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY=> Summary (min/max/mean/last)
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES=> Delta-encoded series
+// <i> Default: SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_BLE_CONTENT
+#define SL_SIDEWALK_SENSOR_AGGREGATION_BLE_CONTENT SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_FSK_WINDOW_MS> Window on the FSK link [ms]
+// <i> Default: 60000
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_FSK_WINDOW_MS
+#define SL_SIDEWALK_SENSOR_AGGREGATION_FSK_WINDOW_MS 60000
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_FSK_CONTENT> Report content on the FSK link
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY=> Summary (min/max/mean/last)
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES=> Delta-encoded series
+// <i> Default: SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_FSK_CONTENT
+#define SL_SIDEWALK_SENSOR_AGGREGATION_FSK_CONTENT SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_LORA_WINDOW_MS> Window on the LoRa (CSS) link [ms]
+// <i> Default: 300000
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_LORA_WINDOW_MS
+#define SL_SIDEWALK_SENSOR_AGGREGATION_LORA_WINDOW_MS 300000
+#endif
+
+// <o SL_SIDEWALK_SENSOR_AGGREGATION_LORA_CONTENT> Report content on the LoRa (CSS) link
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY=> Summary (min/max/mean/last)
+// <SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES=> Delta-encoded series
+// <i> Default: SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_LORA_CONTENT
+#define SL_SIDEWALK_SENSOR_AGGREGATION_LORA_CONTENT SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_SIDEWALK_SENSOR_CONFIG_H
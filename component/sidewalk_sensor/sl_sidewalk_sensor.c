@@ -45,6 +45,8 @@
 
 #include "sl_sidewalk_sender.h"
 #include "sl_sidewalk_sensor.h"
+#include "sl_sidewalk_sensor_aggregation.h"
+#include "sl_sidewalk_sensor_config.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -52,10 +54,17 @@
 
 #define MAX_REPORT_LENGTH_CHAR (64)
 
+#if SL_SIDEWALK_SENSOR_AGGREGATION && !SL_SIDEWALK_SENSOR_BINARY_REPORT
+#error "SL_SIDEWALK_SENSOR_AGGREGATION requires SL_SIDEWALK_SENSOR_BINARY_REPORT"
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+static size_t encode_reading(const sl_sidewalk_sensor_reading_t *reading, uint8_t *buffer, size_t buffer_size);
+static void put_le(uint8_t *buffer, uint32_t value, uint8_t width);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -78,7 +87,9 @@ static const char * SENSOR_PREFIXES[] = {
 
 void sl_sidewalk_sensor_init(void)
 {
-  // Empty initializer kept to meet the sidewalk component pattern
+#if SL_SIDEWALK_SENSOR_AGGREGATION
+  sl_sidewalk_sensor_aggregation_init();
+#endif
 }
 
 void sl_sidewalk_sensor_report(sl_sidewalk_sensor_type_t sensor, char *value, sl_sidewalk_sender_priority_type_t priority)
@@ -86,11 +97,161 @@ void sl_sidewalk_sensor_report(sl_sidewalk_sensor_type_t sensor, char *value, sl
   if ((sensor >= 0) && (sensor < SL_SIDEWALK_SENSOR_TYPE_END)) {
     if (value != NULL) {
       char msg_buffer[MAX_REPORT_LENGTH_CHAR];
-      memset(msg_buffer, 0, sizeof(msg_buffer));
+      int msg_length = snprintf(msg_buffer, sizeof(msg_buffer), "%s%s", SENSOR_PREFIXES[sensor], value);
 
-      strcat(msg_buffer, SENSOR_PREFIXES[sensor]);
-      strcat(msg_buffer, value);
-      sl_sidewalk_sender_queue_message(msg_buffer, strlen(msg_buffer), priority);
+      if ((msg_length > 0) && ((size_t)msg_length < sizeof(msg_buffer))) {
+        sl_sidewalk_sender_queue_message((uint8_t *)msg_buffer, (size_t)msg_length, priority);
+      }
     }
   }
 }
+
+void sl_sidewalk_sensor_report_int(sl_sidewalk_sensor_type_t sensor, int32_t value, sl_sidewalk_sender_priority_type_t priority)
+{
+#if SL_SIDEWALK_SENSOR_AGGREGATION
+  if ((SL_SIDEWALK_SENSOR_AGGREGATION_SENSOR_MASK & (1UL << sensor)) != 0) {
+    sl_sidewalk_sensor_aggregation_add(sensor, value, priority);
+    return;
+  }
+#endif
+
+#if SL_SIDEWALK_SENSOR_BINARY_REPORT
+  sl_sidewalk_sensor_reading_t reading = {
+    .sensor = sensor,
+    .kind = SL_SIDEWALK_SENSOR_VALUE_INT,
+    .value.int_value = value
+  };
+
+  (void)sl_sidewalk_sensor_report_readings(&reading, 1, priority);
+#else
+  char number_buffer[16];
+
+  if (sensor == SL_SIDEWALK_SENSOR_TYPE_TEMPERATURE) {
+    int32_t abs_value = (value < 0) ? -value : value;
+    snprintf(number_buffer, sizeof(number_buffer), "%s%ld.%02ld",
+             (value < 0) ? "-" : "", (long)(abs_value / 100), (long)(abs_value % 100));
+  } else {
+    snprintf(number_buffer, sizeof(number_buffer), "%ld", (long)value);
+  }
+  sl_sidewalk_sensor_report(sensor, number_buffer, priority);
+#endif
+}
+
+bool sl_sidewalk_sensor_report_readings(const sl_sidewalk_sensor_reading_t *readings, uint8_t reading_count, sl_sidewalk_sender_priority_type_t priority)
+{
+  uint8_t msg_buffer[SL_SIDEWALK_SENSOR_REPORT_MSG_MAX_SIZE_BYTES];
+  size_t msg_length = sl_sidewalk_sensor_encode(readings, reading_count, msg_buffer, sizeof(msg_buffer));
+
+  if (msg_length == 0) {
+    return false;
+  }
+
+  return sl_sidewalk_sender_queue_message(msg_buffer, msg_length, priority);
+}
+
+size_t sl_sidewalk_sensor_encode(const sl_sidewalk_sensor_reading_t *readings, uint8_t reading_count, uint8_t *buffer, size_t buffer_size)
+{
+  if ((readings == NULL) || (reading_count == 0) || (buffer == NULL) || (buffer_size < 1)) {
+    return 0;
+  }
+
+  size_t length = 0;
+  buffer[length++] = SL_SIDEWALK_SENSOR_BINARY_REPORT_VERSION;
+
+  for (uint8_t reading_ix = 0; reading_ix < reading_count; reading_ix++) {
+    size_t reading_length = encode_reading(&readings[reading_ix], &buffer[length], buffer_size - length);
+
+    if (reading_length == 0) {
+      return 0;
+    }
+    length += reading_length;
+  }
+
+  return length;
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static size_t encode_reading(const sl_sidewalk_sensor_reading_t *reading, uint8_t *buffer, size_t buffer_size)
+{
+  sl_sidewalk_sensor_binary_field_t field;
+  size_t field_length;
+
+  if (((uint32_t)reading->sensor >= SL_SIDEWALK_SENSOR_TYPE_END)
+      || ((uint32_t)reading->sensor > SL_SIDEWALK_SENSOR_BINARY_TAG_SENSOR_MASK)) {
+    return 0;
+  }
+
+  switch (reading->kind) {
+    case SL_SIDEWALK_SENSOR_VALUE_NONE:
+      field = SL_SIDEWALK_SENSOR_BINARY_FIELD_NONE;
+      field_length = 0;
+      break;
+    case SL_SIDEWALK_SENSOR_VALUE_INT:
+      if ((reading->value.int_value >= INT8_MIN) && (reading->value.int_value <= INT8_MAX)) {
+        field = SL_SIDEWALK_SENSOR_BINARY_FIELD_INT8;
+        field_length = sizeof(int8_t);
+      } else if ((reading->value.int_value >= INT16_MIN) && (reading->value.int_value <= INT16_MAX)) {
+        field = SL_SIDEWALK_SENSOR_BINARY_FIELD_INT16;
+        field_length = sizeof(int16_t);
+      } else {
+        field = SL_SIDEWALK_SENSOR_BINARY_FIELD_INT32;
+        field_length = sizeof(int32_t);
+      }
+      break;
+    case SL_SIDEWALK_SENSOR_VALUE_FLOAT:
+      field = SL_SIDEWALK_SENSOR_BINARY_FIELD_FLOAT32;
+      field_length = sizeof(float);
+      break;
+    case SL_SIDEWALK_SENSOR_VALUE_BYTES:
+      if ((reading->value.bytes.data == NULL) && (reading->value.bytes.length > 0)) {
+        return 0;
+      }
+      field = SL_SIDEWALK_SENSOR_BINARY_FIELD_BYTES;
+      field_length = 1u + (size_t)reading->value.bytes.length;
+      break;
+    default:
+      return 0;
+  }
+
+  // Tag byte and the field
+  if ((1u + field_length) > buffer_size) {
+    return 0;
+  }
+
+  buffer[0] = (uint8_t)((field << SL_SIDEWALK_SENSOR_BINARY_TAG_FIELD_SHIFT) | (uint8_t)reading->sensor);
+
+  switch (field) {
+    case SL_SIDEWALK_SENSOR_BINARY_FIELD_INT8:
+    case SL_SIDEWALK_SENSOR_BINARY_FIELD_INT16:
+    case SL_SIDEWALK_SENSOR_BINARY_FIELD_INT32:
+      put_le(&buffer[1], (uint32_t)reading->value.int_value, (uint8_t)field_length);
+      break;
+    case SL_SIDEWALK_SENSOR_BINARY_FIELD_FLOAT32:
+    {
+      uint32_t raw;
+      memcpy(&raw, &reading->value.float_value, sizeof(raw));
+      put_le(&buffer[1], raw, (uint8_t)field_length);
+      break;
+    }
+    case SL_SIDEWALK_SENSOR_BINARY_FIELD_BYTES:
+      buffer[1] = reading->value.bytes.length;
+      if (reading->value.bytes.length > 0) {
+        memcpy(&buffer[2], reading->value.bytes.data, reading->value.bytes.length);
+      }
+      break;
+    default:
+      break;
+  }
+
+  return 1u + field_length;
+}
+
+static void put_le(uint8_t *buffer, uint32_t value, uint8_t width)
+{
+  for (uint8_t byte_ix = 0; byte_ix < width; byte_ix++) {
+    buffer[byte_ix] = (uint8_t)(value >> (8 * byte_ix));
+  }
+}
@@ -43,9 +43,11 @@
 // -----------------------------------------------------------------------------
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sl_board_control_config.h"
+#include "sl_sidewalk_sender.h"
 #include "sl_sidewalk_sensor_types.h"
 
 // -----------------------------------------------------------------------------
@@ -54,6 +56,29 @@
 
 #define SL_SIDEWALK_SENSOR_REPORT_MSG_MAX_SIZE_BYTES 64
 
+// Binary report layout: one version byte followed by the readings. Each
+// reading starts with a tag byte holding the field encoding in the upper
+// 3 bits and the sensor type in the lower 5 bits, followed by the field:
+// nothing, a little-endian int8/int16/int32 (the smallest width that fits is
+// chosen), a little-endian IEEE-754 float32 or a length byte and the raw bytes.
+#define SL_SIDEWALK_SENSOR_BINARY_REPORT_VERSION     0x01
+#define SL_SIDEWALK_SENSOR_BINARY_TAG_SENSOR_MASK    0x1F
+#define SL_SIDEWALK_SENSOR_BINARY_TAG_FIELD_SHIFT    5
+
+typedef enum {
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_NONE = 0,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_INT8,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_INT16,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_INT32,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_FLOAT32,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_BYTES,
+  // Aggregated fields: a sample count byte followed by zigzag varints, either
+  // min, max, mean and last or the first sample and the delta of each
+  // further sample to its predecessor
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_SUMMARY,
+  SL_SIDEWALK_SENSOR_BINARY_FIELD_SERIES
+} sl_sidewalk_sensor_binary_field_t;
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -77,4 +102,37 @@ void sl_sidewalk_sensor_init(void);
  *****************************************************************************/
 void sl_sidewalk_sensor_report(sl_sidewalk_sensor_type_t sensor, char *value, sl_sidewalk_sender_priority_type_t priority);
 
+/**************************************************************************//**
+ * Function reporting an integer sensor value. Depending on
+ * SL_SIDEWALK_SENSOR_BINARY_REPORT the value is sent as a binary report or as
+ * text. Temperatures are expected in 0.01 degC.
+ *
+ * @param sensor Type of the sensor whose information is to be sent
+ * @param value The value to be sent
+ * @param priority Priority of the message
+ *****************************************************************************/
+void sl_sidewalk_sensor_report_int(sl_sidewalk_sensor_type_t sensor, int32_t value, sl_sidewalk_sender_priority_type_t priority);
+
+/**************************************************************************//**
+ * Function queuing one binary report frame holding all the given readings
+ *
+ * @param readings Readings to be sent
+ * @param reading_count Number of readings
+ * @param priority Priority of the message
+ * @return true if the frame is encoded and queued, false otherwise
+ *****************************************************************************/
+bool sl_sidewalk_sensor_report_readings(const sl_sidewalk_sensor_reading_t *readings, uint8_t reading_count, sl_sidewalk_sender_priority_type_t priority);
+
+/**************************************************************************//**
+ * Function encoding readings into a binary report frame
+ *
+ * @param readings Readings to be encoded
+ * @param reading_count Number of readings
+ * @param buffer Output buffer
+ * @param buffer_size Size of the output buffer
+ * @return Length of the frame in bytes, 0 if the readings do not fit or are
+ *         invalid
+ *****************************************************************************/
+size_t sl_sidewalk_sensor_encode(const sl_sidewalk_sensor_reading_t *readings, uint8_t reading_count, uint8_t *buffer, size_t buffer_size);
+
 #endif // SL_SIDEWALK_SENSOR_H
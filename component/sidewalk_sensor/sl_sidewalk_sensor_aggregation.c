@@ -0,0 +1,395 @@
+/***************************************************************************//**
+ * @file
+ * @brief sl_sidewalk_sensor_aggregation.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "timers.h"
+#include "app_log.h"
+#include "sl_sidewalk_sender.h"
+#include "sl_sidewalk_sensor.h"
+#include "sl_sidewalk_sensor_aggregation.h"
+#include "sl_sidewalk_sensor_config.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Count of a summary is a single byte
+#define MAX_SUMMARY_SAMPLES (UINT8_MAX)
+#define MAX_VARINT_LENGTH   (5)
+
+typedef struct {
+  int32_t samples[SL_SIDEWALK_SENSOR_AGGREGATION_MAX_SAMPLES];
+  uint8_t count;
+  int32_t min;
+  int32_t max;
+  int32_t last;
+  int64_t sum;
+} aggregation_bucket_t;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+
+static void window_timer_cb(TimerHandle_t timer);
+static void bucket_add(aggregation_bucket_t *bucket, int32_t value, sl_sidewalk_sensor_aggregation_content_t content);
+static size_t encode_frame(uint8_t *buffer, size_t buffer_size, sl_sidewalk_sensor_aggregation_content_t content);
+static size_t encode_varint(uint8_t *buffer, size_t buffer_size, int32_t value);
+static int8_t link_type_to_index(enum sid_link_type link_type);
+static void flush_locked(void);
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+
+static sl_sidewalk_sensor_aggregation_policy_t policies[SID_LINK_TYPE_MAX_IDX] = {
+  [SID_LINK_TYPE_1_IDX] = {
+    .window_ms = SL_SIDEWALK_SENSOR_AGGREGATION_BLE_WINDOW_MS,
+    .content = SL_SIDEWALK_SENSOR_AGGREGATION_BLE_CONTENT
+  },
+  [SID_LINK_TYPE_2_IDX] = {
+    .window_ms = SL_SIDEWALK_SENSOR_AGGREGATION_FSK_WINDOW_MS,
+    .content = SL_SIDEWALK_SENSOR_AGGREGATION_FSK_CONTENT
+  },
+  [SID_LINK_TYPE_3_IDX] = {
+    .window_ms = SL_SIDEWALK_SENSOR_AGGREGATION_LORA_WINDOW_MS,
+    .content = SL_SIDEWALK_SENSOR_AGGREGATION_LORA_CONTENT
+  }
+};
+
+static aggregation_bucket_t buckets[SL_SIDEWALK_SENSOR_TYPE_END];
+static uint8_t frame_buffer[SL_SIDEWALK_SENDER_MESSAGE_MAX_LENGTH_BYTES];
+static uint8_t active_link_ix = SID_LINK_TYPE_1_IDX;
+static size_t active_mtu = SL_SIDEWALK_SENSOR_REPORT_MSG_MAX_SIZE_BYTES;
+static sl_sidewalk_sender_priority_type_t pending_priority = SL_SIDEWALK_SENDER_TYPE_PRIORITY_LOW;
+static bool window_open = false;
+static TimerHandle_t window_timer = NULL;
+static SemaphoreHandle_t aggregation_lock = NULL;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+void sl_sidewalk_sensor_aggregation_init(void)
+{
+  memset(buckets, 0, sizeof(buckets));
+  window_open = false;
+
+  aggregation_lock = xSemaphoreCreateMutex();
+  window_timer = xTimerCreate("sensor_aggregation",
+                              pdMS_TO_TICKS(SL_SIDEWALK_SENSOR_AGGREGATION_BLE_WINDOW_MS),
+                              pdFALSE,
+                              (void *)0,
+                              window_timer_cb);
+}
+
+void sl_sidewalk_sensor_aggregation_add(sl_sidewalk_sensor_type_t sensor, int32_t value, sl_sidewalk_sender_priority_type_t priority)
+{
+  if ((uint32_t)sensor >= SL_SIDEWALK_SENSOR_TYPE_END) {
+    return;
+  }
+
+  xSemaphoreTake(aggregation_lock, portMAX_DELAY);
+
+  const sl_sidewalk_sensor_aggregation_policy_t *policy = &policies[active_link_ix];
+  aggregation_bucket_t *bucket = &buckets[sensor];
+  uint16_t max_samples = (policy->content == SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES)
+                         ? SL_SIDEWALK_SENSOR_AGGREGATION_MAX_SAMPLES : MAX_SUMMARY_SAMPLES;
+  size_t frame_limit = (active_mtu < sizeof(frame_buffer)) ? active_mtu : sizeof(frame_buffer);
+
+  if (bucket->count >= max_samples) {
+    flush_locked();
+  }
+
+  // Keep the window as it was if the new sample makes the report exceed the
+  // MTU, the sample then opens the next window
+  aggregation_bucket_t previous = *bucket;
+  bucket_add(bucket, value, policy->content);
+
+  if (encode_frame(frame_buffer, frame_limit, policy->content) == 0) {
+    *bucket = previous;
+    flush_locked();
+    bucket_add(bucket, value, policy->content);
+
+    if (encode_frame(frame_buffer, frame_limit, policy->content) == 0) {
+      // Not even a single aggregated sample fits, report it as it is
+      memset(bucket, 0, sizeof(*bucket));
+      sl_sidewalk_sensor_reading_t reading = {
+        .sensor = sensor,
+        .kind = SL_SIDEWALK_SENSOR_VALUE_INT,
+        .value.int_value = value
+      };
+      (void)sl_sidewalk_sensor_report_readings(&reading, 1, priority);
+      xSemaphoreGive(aggregation_lock);
+      return;
+    }
+  }
+
+  // The report is sent with the highest priority of its samples
+  if (!window_open || (priority > pending_priority)) {
+    pending_priority = priority;
+  }
+
+  if (!window_open) {
+    window_open = true;
+    if ((window_timer != NULL) && (policy->window_ms > 0)) {
+      xTimerChangePeriod(window_timer, pdMS_TO_TICKS(policy->window_ms), 0);
+    }
+  }
+
+  xSemaphoreGive(aggregation_lock);
+}
+
+void sl_sidewalk_sensor_aggregation_set_link(struct sid_handle *sidewalk_handle, enum sid_link_type link_type)
+{
+  int8_t link_ix = link_type_to_index(link_type);
+  size_t mtu = 0;
+
+  if (link_ix < 0) {
+    return;
+  }
+
+  if ((sid_get_mtu(sidewalk_handle, link_type, &mtu) != SID_ERROR_NONE) || (mtu == 0)) {
+    app_log_warning("sensor aggregation: MTU query failed, link %d", (int)link_type);
+    return;
+  }
+
+  xSemaphoreTake(aggregation_lock, portMAX_DELAY);
+  if (((uint8_t)link_ix != active_link_ix) || (mtu != active_mtu)) {
+    // Pending samples were collected for the previous policy
+    flush_locked();
+    active_link_ix = (uint8_t)link_ix;
+    active_mtu = mtu;
+  }
+  xSemaphoreGive(aggregation_lock);
+}
+
+void sl_sidewalk_sensor_aggregation_set_policy(enum sid_link_type link_type, const sl_sidewalk_sensor_aggregation_policy_t *policy)
+{
+  int8_t link_ix = link_type_to_index(link_type);
+
+  if ((link_ix < 0) || (policy == NULL)) {
+    return;
+  }
+
+  xSemaphoreTake(aggregation_lock, portMAX_DELAY);
+  if ((uint8_t)link_ix == active_link_ix) {
+    flush_locked();
+  }
+  policies[link_ix] = *policy;
+  xSemaphoreGive(aggregation_lock);
+}
+
+void sl_sidewalk_sensor_aggregation_flush(void)
+{
+  xSemaphoreTake(aggregation_lock, portMAX_DELAY);
+  flush_locked();
+  xSemaphoreGive(aggregation_lock);
+}
+
+void sl_sidewalk_sensor_aggregation_status_changed(struct sid_handle *sidewalk_handle, const struct sid_status *status)
+{
+  if ((sidewalk_handle == NULL) || (status == NULL) || (status->state != SID_STATE_READY)) {
+    return;
+  }
+
+  // Follow the most constrained link that is up
+  if ((status->detail.link_status_mask & SID_LINK_TYPE_3) != 0) {
+    sl_sidewalk_sensor_aggregation_set_link(sidewalk_handle, SID_LINK_TYPE_3);
+  } else if ((status->detail.link_status_mask & SID_LINK_TYPE_2) != 0) {
+    sl_sidewalk_sensor_aggregation_set_link(sidewalk_handle, SID_LINK_TYPE_2);
+  } else if ((status->detail.link_status_mask & SID_LINK_TYPE_1) != 0) {
+    sl_sidewalk_sensor_aggregation_set_link(sidewalk_handle, SID_LINK_TYPE_1);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+static void window_timer_cb(TimerHandle_t timer)
+{
+  (void)timer;
+  sl_sidewalk_sensor_aggregation_flush();
+}
+
+static void flush_locked(void)
+{
+  if (!window_open) {
+    return;
+  }
+
+  if (window_timer != NULL) {
+    xTimerStop(window_timer, 0);
+  }
+
+  size_t frame_length = encode_frame(frame_buffer, sizeof(frame_buffer), policies[active_link_ix].content);
+  if (frame_length > 0) {
+    if (!sl_sidewalk_sender_queue_message(frame_buffer, frame_length, pending_priority)) {
+      app_log_warning("sensor aggregation: report dropped, sender queue full");
+    }
+  }
+
+  memset(buckets, 0, sizeof(buckets));
+  window_open = false;
+}
+
+static void bucket_add(aggregation_bucket_t *bucket, int32_t value, sl_sidewalk_sensor_aggregation_content_t content)
+{
+  if (bucket->count == 0) {
+    bucket->min = value;
+    bucket->max = value;
+    bucket->sum = 0;
+  } else {
+    bucket->min = (value < bucket->min) ? value : bucket->min;
+    bucket->max = (value > bucket->max) ? value : bucket->max;
+  }
+
+  if (content == SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES) {
+    bucket->samples[bucket->count] = value;
+  }
+
+  bucket->sum += value;
+  bucket->last = value;
+  bucket->count++;
+}
+
+static size_t encode_frame(uint8_t *buffer, size_t buffer_size, sl_sidewalk_sensor_aggregation_content_t content)
+{
+  sl_sidewalk_sensor_binary_field_t field = (content == SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES)
+                                            ? SL_SIDEWALK_SENSOR_BINARY_FIELD_SERIES
+                                            : SL_SIDEWALK_SENSOR_BINARY_FIELD_SUMMARY;
+  size_t length = 0;
+
+  if (buffer_size < 1) {
+    return 0;
+  }
+  buffer[length++] = SL_SIDEWALK_SENSOR_BINARY_REPORT_VERSION;
+
+  for (uint8_t sensor = 0; sensor < SL_SIDEWALK_SENSOR_TYPE_END; sensor++) {
+    const aggregation_bucket_t *bucket = &buckets[sensor];
+    int32_t values[4];
+    uint8_t value_count;
+    size_t varint_length;
+
+    if (bucket->count == 0) {
+      continue;
+    }
+
+    // Tag and sample count
+    if ((length + 2) > buffer_size) {
+      return 0;
+    }
+    buffer[length++] = (uint8_t)((field << SL_SIDEWALK_SENSOR_BINARY_TAG_FIELD_SHIFT) | sensor);
+    buffer[length++] = bucket->count;
+
+    if (field == SL_SIDEWALK_SENSOR_BINARY_FIELD_SUMMARY) {
+      values[0] = bucket->min;
+      values[1] = bucket->max;
+      values[2] = (int32_t)(bucket->sum / bucket->count);
+      values[3] = bucket->last;
+      value_count = 4;
+
+      for (uint8_t value_ix = 0; value_ix < value_count; value_ix++) {
+        varint_length = encode_varint(&buffer[length], buffer_size - length, values[value_ix]);
+        if (varint_length == 0) {
+          return 0;
+        }
+        length += varint_length;
+      }
+    } else {
+      for (uint8_t sample_ix = 0; sample_ix < bucket->count; sample_ix++) {
+        // Deltas wrap around like the decoder's 32-bit arithmetic
+        int32_t delta = (sample_ix == 0)
+                        ? bucket->samples[0]
+                        : (int32_t)((uint32_t)bucket->samples[sample_ix] - (uint32_t)bucket->samples[sample_ix - 1]);
+        varint_length = encode_varint(&buffer[length], buffer_size - length, delta);
+        if (varint_length == 0) {
+          return 0;
+        }
+        length += varint_length;
+      }
+    }
+  }
+
+  return length;
+}
+
+static size_t encode_varint(uint8_t *buffer, size_t buffer_size, int32_t value)
+{
+  // Zigzag encoding keeps small negative deltas short
+  uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+  size_t length = 0;
+
+  do {
+    if (length >= buffer_size || length >= MAX_VARINT_LENGTH) {
+      return 0;
+    }
+    buffer[length] = (uint8_t)(zigzag & 0x7F);
+    zigzag >>= 7;
+    if (zigzag != 0) {
+      buffer[length] |= 0x80;
+    }
+    length++;
+  } while (zigzag != 0);
+
+  return length;
+}
+
+static int8_t link_type_to_index(enum sid_link_type link_type)
+{
+  switch (link_type) {
+    case SID_LINK_TYPE_1:
+      return SID_LINK_TYPE_1_IDX;
+    case SID_LINK_TYPE_2:
+      return SID_LINK_TYPE_2_IDX;
+    case SID_LINK_TYPE_3:
+      return SID_LINK_TYPE_3_IDX;
+    default:
+      return -1;
+  }
+}
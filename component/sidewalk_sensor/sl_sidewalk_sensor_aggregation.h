@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file
+ * @brief sl_sidewalk_sensor_aggregation.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SIDEWALK_SENSOR_AGGREGATION_H
+#define SL_SIDEWALK_SENSOR_AGGREGATION_H
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sid_api.h"
+#include "sl_sidewalk_sender.h"
+#include "sl_sidewalk_sensor_types.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+typedef enum {
+  SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SUMMARY = 0,
+  SL_SIDEWALK_SENSOR_AGGREGATION_CONTENT_SERIES
+} sl_sidewalk_sensor_aggregation_content_t;
+
+// Flush policy applied while a given link type is in use
+typedef struct {
+  uint32_t window_ms;
+  sl_sidewalk_sensor_aggregation_content_t content;
+} sl_sidewalk_sensor_aggregation_policy_t;
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Initializer of the sensor aggregation, called by sl_sidewalk_sensor_init()
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_init(void);
+
+/**************************************************************************//**
+ * Function adding a sample to the aggregation window of a sensor. The window
+ * is flushed as one binary report when it closes, when the report would not
+ * fit into the MTU of the active link or when the sample buffer is full.
+ *
+ * @param sensor Type of the sensor
+ * @param value The sample
+ * @param priority Priority of the report
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_add(sl_sidewalk_sensor_type_t sensor, int32_t value, sl_sidewalk_sender_priority_type_t priority);
+
+/**************************************************************************//**
+ * Function selecting the link whose policy and MTU are used for flushing. It
+ * is called by sl_sidewalk_sensor_aggregation_status_changed() or directly
+ * when the application picks the link itself.
+ *
+ * @param sidewalk_handle Sidewalk handle used to query the MTU
+ * @param link_type The link the reports are sent on
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_set_link(struct sid_handle *sidewalk_handle, enum sid_link_type link_type);
+
+/**************************************************************************//**
+ * Function following the active link from the status of the Sidewalk stack.
+ * The application calls it from the on_status_changed callback it registers
+ * with sid_init(), the most constrained link that is up is then used.
+ *
+ * @param sidewalk_handle Sidewalk handle used to query the MTU
+ * @param status Status reported by the stack
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_status_changed(struct sid_handle *sidewalk_handle, const struct sid_status *status);
+
+/**************************************************************************//**
+ * Function overriding the configured flush policy of a link type
+ *
+ * @param link_type The link type the policy applies to
+ * @param policy The new policy
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_set_policy(enum sid_link_type link_type, const sl_sidewalk_sensor_aggregation_policy_t *policy);
+
+/**************************************************************************//**
+ * Function sending the pending samples immediately
+ *****************************************************************************/
+void sl_sidewalk_sensor_aggregation_flush(void);
+
+#endif // SL_SIDEWALK_SENSOR_AGGREGATION_H
@@ -42,6 +42,8 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 
+#include <stdint.h>
+
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
@@ -55,6 +57,28 @@ typedef enum {
   SL_SIDEWALK_SENSOR_TYPE_END
 } sl_sidewalk_sensor_type_t;
 
+typedef enum {
+  SL_SIDEWALK_SENSOR_VALUE_NONE = 0,
+  SL_SIDEWALK_SENSOR_VALUE_INT,
+  SL_SIDEWALK_SENSOR_VALUE_FLOAT,
+  SL_SIDEWALK_SENSOR_VALUE_BYTES
+} sl_sidewalk_sensor_value_kind_t;
+
+// One sensor reading of a binary report. Temperatures are reported as integer
+// values in 0.01 degC.
+typedef struct {
+  sl_sidewalk_sensor_type_t sensor;
+  sl_sidewalk_sensor_value_kind_t kind;
+  union {
+    int32_t int_value;
+    float float_value;
+    struct {
+      const uint8_t *data;
+      uint8_t length;
+    } bytes;
+  } value;
+} sl_sidewalk_sensor_reading_t;
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -43,6 +43,31 @@
 #define SL_SIDEWALK_UTILS_MSG_TIMEOUT_MS 90000
 #endif
 
+// <o> SL_SIDEWALK_UTILS_MAX_IN_FLIGHT_MESSAGES_NUM <1-5>
+// <i> Maximum number of messages of the same priority waiting for their
+// <i> send acknowledgement at the same time
+// <i> Default: 3
+// <d> 3
+#ifndef SL_SIDEWALK_UTILS_MAX_IN_FLIGHT_MESSAGES_NUM
+#define SL_SIDEWALK_UTILS_MAX_IN_FLIGHT_MESSAGES_NUM 3
+#endif
+
+// </h>
+
+// <h> Sidewalk sender log configuration
+
+// <o SL_SIDEWALK_SENDER_LOG_LEVEL> Compile-time log level of the sender
+// <0=> Critical
+// <1=> Error
+// <2=> Warning
+// <3=> Info
+// <4=> Debug
+// <i> Logs above this level are removed from the build with their strings
+// <i> Default: 4
+#ifndef SL_SIDEWALK_SENDER_LOG_LEVEL
+#define SL_SIDEWALK_SENDER_LOG_LEVEL 4
+#endif
+
 // </h>
 
 #endif // SL_SIDEWALK_UTILS_CONFIG_H
@@ -214,6 +214,10 @@ sx126x_hal_status_t sx126x_hal_read(const void* context, const uint8_t* command,
         if (sx126x_wait_for_device_ready(drv_ctx) != RADIO_ERROR_NONE) {
             break;
         }
+        // Queued writes go out first to keep the command order
+        if (sx126x_radio_batch_flush() != RADIO_ERROR_NONE) {
+            break;
+        }
         if (sx126x_hal_rdwr(context, command, command_length, data, data_length, true) != RADIO_ERROR_NONE) {
             break;
         }
@@ -240,7 +244,11 @@ sx126x_hal_status_t sx126x_hal_write(const void* context, const uint8_t* command
             break;
         }
 
-        if (sx126x_hal_rdwr(context, command, command_length, (uint8_t *)data, data_length, false) != RADIO_ERROR_NONE) {
+        if (sx126x_radio_batch_is_open()) {
+            if (sx126x_radio_batch_queue(command, command_length, data, data_length) != RADIO_ERROR_NONE) {
+                break;
+            }
+        } else if (sx126x_hal_rdwr(context, command, command_length, (uint8_t *)data, data_length, false) != RADIO_ERROR_NONE) {
             break;
         }
         status = SX126X_STATUS_OK;
@@ -9,10 +9,18 @@
 #include <sid_error.h>
 
 #include <sid_clock_ifc.h>
+#include <sid_pal_critical_region_ifc.h>
 #include <sid_pal_delay_ifc.h>
 #include <sid_time_ops.h>
 #include <sid_time_types.h>
 
+#include "radio_noise.h"
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+#include <em_core.h>
+
 #ifdef MARS_SPI_BUS_WORKAROUND
 #include "board_hal.h"
 #endif
@@ -36,9 +44,25 @@
 // Delay time to allow for any external PA/FEM turn ON/OFF
 #define SEMTECH_STDBY_STATE_DELAY_US       10
 #define SEMTECH_MAX_WAIT_ON_BUSY_CNT_US    2000
+#define SEMTECH_MAX_WAIT_ON_BUSY_US        (SEMTECH_MAX_WAIT_ON_BUSY_CNT_US * SEMTECH_STDBY_STATE_DELAY_US)
+// BUSY is polled this long before sleeping on its interrupt, the short pulses
+// that follow most commands end sooner than a wake up from EM2 would take
+#define SEMTECH_BUSY_SPIN_US               50
+#define SEMTECH_BUSY_SPIN_STEP_US          2
 
 #define SX126X_TCXO_VDD_TIMEOUT_DURATION   1
 
+// Bus transactions of the settings kept in the shadow configuration
+#if defined (RADIO_SX1262_TXPWR_WORKAROUND) && RADIO_SX1262_TXPWR_WORKAROUND
+#define SX126X_SHADOW_FREQ_XFERS           2
+#define SX126X_SHADOW_TX_POWER_XFERS       5
+#else
+#define SX126X_SHADOW_FREQ_XFERS           1
+#define SX126X_SHADOW_TX_POWER_XFERS       3
+#endif
+#define SX126X_SHADOW_LORA_MOD_XFERS       1
+#define SX126X_SHADOW_FSK_PKT_XFERS        1
+
 #if defined (RADIO_SX1262_TXPWR_WORKAROUND) && RADIO_SX1262_TXPWR_WORKAROUND
 
 #define SX1262_BAND_EDGE_LIMIT_FREQ        903000000
@@ -50,6 +74,36 @@
 #define SX126X_CAD_DEFAULT_TX_TIMEOUT      0 // disable Tx timeout for CAD
 
 static halo_drv_semtech_ctx_t              drv_ctx = {0};
+static SemaphoreHandle_t                   busy_event = NULL;
+static sx126x_radio_busy_stats_t           busy_stats = {0};
+static sx126x_radio_shadow_stats_t         shadow_stats = {0};
+
+static void radio_shadow_invalidate(uint8_t settings)
+{
+    drv_ctx.shadow.valid &= ~settings;
+}
+
+static bool radio_shadow_hit(uint8_t setting, uint8_t xfers)
+{
+    if ((drv_ctx.shadow.valid & setting) == 0) {
+        return false;
+    }
+
+    shadow_stats.skipped++;
+    shadow_stats.saved_xfers += xfers;
+    return true;
+}
+
+static void radio_busy_irq(uint32_t pin, void * callback_arg)
+{
+    (void)pin;
+    (void)callback_arg;
+
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    xSemaphoreGiveFromISR(busy_event, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
 
 static int32_t radio_sx126x_platform_init(void)
 {
@@ -71,6 +125,23 @@ static int32_t radio_sx126x_platform_init(void)
             SID_PAL_GPIO_DIRECTION_INPUT) != SID_ERROR_NONE) {
             goto ret;
         }
+
+        // Falling edge of BUSY wakes up the waiting task, armed only during a wait
+        if (busy_event == NULL) {
+            if ((busy_event = xSemaphoreCreateBinary()) == NULL) {
+                err = RADIO_ERROR_NOMEM;
+                goto ret;
+            }
+        }
+
+        if (sid_pal_gpio_set_irq(drv_ctx.config->gpio_radio_busy, SID_PAL_GPIO_IRQ_TRIGGER_FALLING,
+            radio_busy_irq, NULL) != SID_ERROR_NONE) {
+            goto ret;
+        }
+
+        if (sid_pal_gpio_irq_disable(drv_ctx.config->gpio_radio_busy) != SID_ERROR_NONE) {
+            goto ret;
+        }
     }
 
     if (drv_ctx.config->gpio_tx_bypass != HALO_GPIO_NOT_CONNECTED) {
@@ -168,6 +239,8 @@ static int32_t sx126x_check_status(void)
 
 static int32_t radio_set_modem_to_lora_mode(void)
 {
+    // Modulation and packet parameters are tied to the packet type
+    radio_shadow_invalidate(SX126X_SHADOW_LORA_MOD_PARAMS | SX126X_SHADOW_FSK_PKT_PARAMS);
     if (sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_LORA) != SX126X_STATUS_OK) {
         return RADIO_ERROR_HARDWARE_ERROR;
     }
@@ -182,6 +255,7 @@ static int32_t radio_set_modem_to_lora_mode(void)
 
 static int32_t radio_set_modem_to_fsk_mode(void)
 {
+    radio_shadow_invalidate(SX126X_SHADOW_LORA_MOD_PARAMS | SX126X_SHADOW_FSK_PKT_PARAMS);
     if (sx126x_set_pkt_type(&drv_ctx, SX126X_PKT_TYPE_GFSK) != SX126X_STATUS_OK) {
         return RADIO_ERROR_HARDWARE_ERROR;
     }
@@ -236,6 +310,104 @@ static int32_t radio_clear_irq_status_all(void)
     return RADIO_ERROR_NONE;
 }
 
+static void radio_bus_xfer_done(sid_error_t status, void *arg)
+{
+    (void)arg;
+
+    drv_ctx.xfer_status = (status == SID_ERROR_NONE) ? RADIO_ERROR_NONE : RADIO_ERROR_IO_ERROR;
+    drv_ctx.xfer_pending = false;
+
+    if (busy_event != NULL) {
+        BaseType_t higher_priority_task_woken = pdFALSE;
+
+        xSemaphoreGiveFromISR(busy_event, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+}
+
+static int32_t radio_busy_status(void)
+{
+    if (drv_ctx.xfer_pending) {
+        return RADIO_ERROR_BUSY;
+    }
+
+    return sx126x_check_status();
+}
+
+static int32_t radio_busy_poll(void)
+{
+    uint16_t cnt = 0;
+    int32_t err;
+
+    while ((err = radio_busy_status()) == RADIO_ERROR_BUSY) {
+        if (cnt++ >= SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
+            return RADIO_ERROR_HARDWARE_ERROR;
+        }
+
+        sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
+    }
+
+    return err;
+}
+
+static int32_t radio_busy_spin(void)
+{
+    uint16_t cnt = 0;
+    int32_t err;
+
+    while ((err = radio_busy_status()) == RADIO_ERROR_BUSY
+           && cnt++ < SEMTECH_BUSY_SPIN_US / SEMTECH_BUSY_SPIN_STEP_US) {
+        sid_pal_delay_us(SEMTECH_BUSY_SPIN_STEP_US);
+    }
+
+    return err;
+}
+
+static int32_t radio_busy_block(void)
+{
+    const TickType_t timeout = pdMS_TO_TICKS(SEMTECH_MAX_WAIT_ON_BUSY_US / US_IN_MSEC) + 1;
+    const TickType_t start = xTaskGetTickCount();
+    int32_t err;
+
+    (void)xSemaphoreTake(busy_event, 0);
+    sid_pal_gpio_irq_enable(drv_ctx.config->gpio_radio_busy);
+
+    // Checked again once armed, BUSY may have dropped in between
+    while ((err = radio_busy_status()) == RADIO_ERROR_BUSY) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (elapsed >= timeout || xSemaphoreTake(busy_event, timeout - elapsed) != pdTRUE) {
+            err = (radio_busy_status() == RADIO_ERROR_NONE) ? RADIO_ERROR_NONE : RADIO_ERROR_HARDWARE_ERROR;
+            break;
+        }
+    }
+
+    sid_pal_gpio_irq_disable(drv_ctx.config->gpio_radio_busy);
+
+    return err;
+}
+
+static int32_t radio_bus_send_frame(uint8_t *frame, uint16_t length)
+{
+    const struct sid_pal_serial_bus_iface *bus_iface = drv_ctx.bus_iface;
+
+    // Let the DMA clock the command out, sx126x_wait_on_busy() waits for it
+    if (drv_ctx.config->bus_xfer_async != NULL) {
+        drv_ctx.xfer_pending = true;
+        if (drv_ctx.config->bus_xfer_async(bus_iface, &drv_ctx.config->bus_selector, frame, frame, length,
+                                           radio_bus_xfer_done, NULL) == SID_ERROR_NONE) {
+            return RADIO_ERROR_NONE;
+        }
+        drv_ctx.xfer_pending = false;
+    }
+
+    if (bus_iface->xfer(bus_iface, &drv_ctx.config->bus_selector, frame, frame, length) != SID_ERROR_NONE) {
+        return RADIO_ERROR_IO_ERROR;
+    }
+
+    return RADIO_ERROR_NONE;
+}
+
 const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void)
 {
     return &drv_ctx;
@@ -243,23 +415,126 @@ const halo_drv_semtech_ctx_t* sx126x_get_drv_ctx(void)
 
 int32_t sx126x_wait_on_busy(void)
 {
-    uint16_t cnt = 0;
+    int32_t err;
+    bool waited = false;
+    bool blocked = false;
+    uint32_t busy_us = 0;
+
+    if ((err = radio_busy_status()) == RADIO_ERROR_BUSY) {
+        struct sid_timespec t_start, t_end;
+        bool can_block = busy_event != NULL && !CORE_InIrqContext() && !CORE_IrqIsDisabled()
+                         && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+
+        sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_start, NULL);
+        if (can_block) {
+            // Sleep on the BUSY interrupt only if the radio stays busy past the spin
+            if ((err = radio_busy_spin()) == RADIO_ERROR_BUSY) {
+                blocked = true;
+                err = radio_busy_block();
+            }
+        } else {
+            err = radio_busy_poll();
+        }
+        sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_end, NULL);
 
-    while(cnt++ < SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        if (sx126x_check_status() == RADIO_ERROR_NONE) {
-            break;
+        sid_time_sub(&t_end, &t_start);
+        busy_us = sid_timespec_to_us(&t_end);
+        waited = true;
+    }
+
+    sid_pal_enter_critical_region();
+    busy_stats.calls++;
+    if (waited) {
+        busy_stats.waits++;
+        busy_stats.blocked_waits += blocked ? 1 : 0;
+        busy_stats.timeouts += (err == RADIO_ERROR_HARDWARE_ERROR) ? 1 : 0;
+        busy_stats.total_us += busy_us;
+        if (busy_us > busy_stats.max_us) {
+            busy_stats.max_us = busy_us;
         }
+    }
+    sid_pal_exit_critical_region();
 
-        sid_pal_delay_us(SEMTECH_STDBY_STATE_DELAY_US);
+    if (err != RADIO_ERROR_NONE) {
+        return err;
     }
 
-    if (cnt >= SEMTECH_MAX_WAIT_ON_BUSY_CNT_US) {
-        return RADIO_ERROR_HARDWARE_ERROR;
+    // Report the failure of a command that was left on the bus
+    if (drv_ctx.xfer_status != RADIO_ERROR_NONE) {
+        int32_t err = drv_ctx.xfer_status;
+        drv_ctx.xfer_status = RADIO_ERROR_NONE;
+        return err;
     }
 
     return RADIO_ERROR_NONE;
 }
 
+void sx126x_radio_get_busy_stats(sx126x_radio_busy_stats_t *stats)
+{
+    sid_pal_enter_critical_region();
+    *stats = busy_stats;
+    sid_pal_exit_critical_region();
+}
+
+void sx126x_radio_reset_busy_stats(void)
+{
+    sid_pal_enter_critical_region();
+    memset(&busy_stats, 0, sizeof(busy_stats));
+    sid_pal_exit_critical_region();
+}
+
+bool sx126x_radio_shadow_has_lora_mod_params(const sx126x_mod_params_lora_t *params)
+{
+    const sx126x_mod_params_lora_t *shadow = &drv_ctx.shadow.lora_mod_params;
+
+    if (shadow->sf != params->sf || shadow->bw != params->bw || shadow->cr != params->cr ||
+        shadow->ldro != params->ldro) {
+        return false;
+    }
+
+    return radio_shadow_hit(SX126X_SHADOW_LORA_MOD_PARAMS, SX126X_SHADOW_LORA_MOD_XFERS);
+}
+
+void sx126x_radio_shadow_set_lora_mod_params(const sx126x_mod_params_lora_t *params)
+{
+    drv_ctx.shadow.lora_mod_params = *params;
+    drv_ctx.shadow.valid |= SX126X_SHADOW_LORA_MOD_PARAMS;
+}
+
+bool sx126x_radio_shadow_has_fsk_pkt_params(const sx126x_pkt_params_gfsk_t *params)
+{
+    const sx126x_pkt_params_gfsk_t *shadow = &drv_ctx.shadow.fsk_pkt_params;
+
+    if (shadow->pbl_len_in_bits != params->pbl_len_in_bits || shadow->pbl_min_det != params->pbl_min_det ||
+        shadow->sync_word_len_in_bits != params->sync_word_len_in_bits || shadow->addr_cmp != params->addr_cmp ||
+        shadow->hdr_type != params->hdr_type || shadow->pld_len_in_bytes != params->pld_len_in_bytes ||
+        shadow->crc_type != params->crc_type || shadow->dc_free != params->dc_free) {
+        return false;
+    }
+
+    return radio_shadow_hit(SX126X_SHADOW_FSK_PKT_PARAMS, SX126X_SHADOW_FSK_PKT_XFERS);
+}
+
+void sx126x_radio_shadow_set_fsk_pkt_params(const sx126x_pkt_params_gfsk_t *params)
+{
+    drv_ctx.shadow.fsk_pkt_params = *params;
+    drv_ctx.shadow.valid |= SX126X_SHADOW_FSK_PKT_PARAMS;
+}
+
+void sx126x_radio_get_shadow_stats(sx126x_radio_shadow_stats_t *stats)
+{
+    sid_pal_enter_critical_region();
+    *stats = shadow_stats;
+    sid_pal_exit_critical_region();
+}
+
+void sx126x_radio_reset_shadow_stats(void)
+{
+    sid_pal_enter_critical_region();
+    memset(&shadow_stats, 0, sizeof(shadow_stats));
+    sid_pal_exit_critical_region();
+}
+
 void set_lora_exit_mode(sid_pal_radio_cad_param_exit_mode_t cad_exit_mode)
 {
     drv_ctx.cad_exit_mode = cad_exit_mode;
@@ -302,6 +577,93 @@ int32_t sx126x_radio_bus_xfer(const uint8_t *cmd_buffer, uint16_t cmd_buffer_siz
     return RADIO_ERROR_NONE;
 }
 
+void sx126x_radio_batch_begin(void)
+{
+    drv_ctx.batch.depth++;
+}
+
+bool sx126x_radio_batch_is_open(void)
+{
+    return drv_ctx.batch.depth > 0;
+}
+
+int32_t sx126x_radio_batch_queue(const uint8_t *cmd_buffer, uint16_t cmd_buffer_size, const uint8_t *buffer,
+                                 uint16_t size)
+{
+    int32_t err;
+    uint16_t length = cmd_buffer_size + size;
+
+    if (drv_ctx.config->internal_buffer.p == NULL || cmd_buffer == NULL) {
+        return RADIO_ERROR_INVALID_PARAMS;
+    }
+
+    if (drv_ctx.config->internal_buffer.size < length) {
+        return RADIO_ERROR_NOMEM;
+    }
+
+    if (drv_ctx.batch.count == SX126X_BATCH_MAX_CMDS ||
+        (drv_ctx.config->internal_buffer.size - drv_ctx.batch.used) < length) {
+        if ((err = sx126x_radio_batch_flush()) != RADIO_ERROR_NONE) {
+            return err;
+        }
+    }
+
+    // The last command sent may still be read out of the buffer
+    if (drv_ctx.batch.used == 0 && (err = sx126x_wait_on_busy()) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    uint8_t *frame = &drv_ctx.config->internal_buffer.p[drv_ctx.batch.used];
+
+    memcpy(frame, cmd_buffer, cmd_buffer_size);
+    if (buffer != NULL) {
+        memcpy(&frame[cmd_buffer_size], buffer, size);
+    }
+
+    drv_ctx.batch.length[drv_ctx.batch.count++] = length;
+    drv_ctx.batch.used += length;
+
+    return RADIO_ERROR_NONE;
+}
+
+int32_t sx126x_radio_batch_flush(void)
+{
+    int32_t err = RADIO_ERROR_NONE;
+    uint16_t offset = 0;
+
+    for (uint8_t i = 0; i < drv_ctx.batch.count; i++) {
+        // Each command needs its own chip select, the radio is busy in between
+        if ((err = sx126x_wait_on_busy()) != RADIO_ERROR_NONE) {
+            break;
+        }
+
+        if ((err = radio_bus_send_frame(&drv_ctx.config->internal_buffer.p[offset],
+              drv_ctx.batch.length[i])) != RADIO_ERROR_NONE) {
+            break;
+        }
+
+        offset += drv_ctx.batch.length[i];
+    }
+
+    drv_ctx.batch.count = 0;
+    drv_ctx.batch.used = 0;
+
+    return err;
+}
+
+int32_t sx126x_radio_batch_commit(void)
+{
+    if (drv_ctx.batch.depth == 0) {
+        return RADIO_ERROR_INVALID_STATE;
+    }
+
+    if (--drv_ctx.batch.depth > 0) {
+        return RADIO_ERROR_NONE;
+    }
+
+    return sx126x_radio_batch_flush();
+}
+
 int32_t radio_sx126x_set_radio_mode(bool rf_en, bool tx_en)
 {
     int32_t err = RADIO_ERROR_NONE;
@@ -516,14 +878,19 @@ uint16_t get_radio_sx126x_trim_cap_val(void)
 
 int32_t sid_pal_radio_set_frequency(uint32_t freq)
 {
-    int32_t err = RADIO_ERROR_NONE;
+    int32_t err = RADIO_ERROR_NONE, batch_err;
 
-    do {
-       if (drv_ctx.radio_state != SID_PAL_RADIO_STANDBY) {
-           err =  RADIO_ERROR_INVALID_STATE;
-           break;
-       }
+    if (drv_ctx.radio_state != SID_PAL_RADIO_STANDBY) {
+        return RADIO_ERROR_INVALID_STATE;
+    }
+
+    if (freq == drv_ctx.radio_freq_hz && radio_shadow_hit(SX126X_SHADOW_FREQ, SX126X_SHADOW_FREQ_XFERS)) {
+        return RADIO_ERROR_NONE;
+    }
 
+    sx126x_radio_batch_begin();
+
+    do {
        sx126x_freq_cal_band cur_freq_band, freq_band;
        cur_freq_band = sx126x_get_freq_band(drv_ctx.radio_freq_hz);
        freq_band = sx126x_get_freq_band(freq);
@@ -572,10 +939,18 @@ int32_t sid_pal_radio_set_frequency(uint32_t freq)
             }
         }
 #endif
+    } while(0);
 
-       drv_ctx.radio_freq_hz = freq;
+    if ((batch_err = sx126x_radio_batch_commit()) != RADIO_ERROR_NONE) {
+        err = batch_err;
+    }
 
-    } while(0);
+    if (err == RADIO_ERROR_NONE) {
+        drv_ctx.radio_freq_hz = freq;
+        drv_ctx.shadow.valid |= SX126X_SHADOW_FREQ;
+    } else {
+        radio_shadow_invalidate(SX126X_SHADOW_FREQ);
+    }
 
     return err;
 }
@@ -602,6 +977,8 @@ int32_t sid_pal_radio_set_region(sid_pal_radio_region_code_t region)
     for (uint8_t i = 0; i < drv_ctx.config->regional_config.reg_param_table_size; i++) {
         if (region == drv_ctx.config->regional_config.reg_param_table[i].param_region) {
             drv_ctx.regional_radio_param = drv_ctx.config->regional_config.reg_param_table[i];
+            // The channels of the previous region are meaningless now
+            sli_sid_pal_radio_noise_flush();
             err = RADIO_ERROR_NONE;
             break;
         }
@@ -629,6 +1006,7 @@ int32_t semtech_radio_set_sx126x_pa_config(semtech_radio_pa_cfg_t *cfg)
 
     drv_ctx.pa_cfg = cur_cfg;
     drv_ctx.pa_cfg_configured = true;
+    radio_shadow_invalidate(SX126X_SHADOW_TX_POWER);
     return RADIO_ERROR_NONE;
 }
 #endif
@@ -652,9 +1030,14 @@ int32_t sid_pal_radio_set_tx_power(int8_t power)
     }
 
 #if HALO_ENABLE_DIAGNOSTICS
+    // A PA configuration set by diagnostics is applied whatever the power is
     if (drv_ctx.pa_cfg_configured == false)
 #endif
     {
+        if (power == drv_ctx.shadow.tx_power && radio_shadow_hit(SX126X_SHADOW_TX_POWER, SX126X_SHADOW_TX_POWER_XFERS)) {
+            return RADIO_ERROR_NONE;
+        }
+
         if (drv_ctx.config->pa_cfg_callback(power, &drv_ctx.pa_cfg) < 0) {
             return RADIO_ERROR_INVALID_PARAMS;
         }
@@ -678,6 +1061,9 @@ int32_t sid_pal_radio_set_tx_power(int8_t power)
     }
 
     if (err == RADIO_ERROR_NONE) {
+        int32_t batch_err;
+
+        sx126x_radio_batch_begin();
         err = RADIO_ERROR_IO_ERROR;
         do {
             if (sx126x_set_pa_cfg(&drv_ctx, &cfg) != SX126X_STATUS_OK) {
@@ -709,6 +1095,17 @@ int32_t sid_pal_radio_set_tx_power(int8_t power)
             }
             err = RADIO_ERROR_NONE;
         } while (0);
+
+        if ((batch_err = sx126x_radio_batch_commit()) != RADIO_ERROR_NONE) {
+            err = batch_err;
+        }
+    }
+
+    if (err == RADIO_ERROR_NONE) {
+        drv_ctx.shadow.tx_power = power;
+        drv_ctx.shadow.valid |= SX126X_SHADOW_TX_POWER;
+    } else {
+        radio_shadow_invalidate(SX126X_SHADOW_TX_POWER);
     }
     return err;
 }
@@ -740,6 +1137,7 @@ int32_t sid_pal_radio_sleep(uint32_t sleep_ms)
 
         set_gpio_cfg_sleep(&drv_ctx);
         drv_ctx.radio_state = SID_PAL_RADIO_SLEEP;
+        radio_shadow_invalidate(SX126X_SHADOW_ALL);
     } while(0);
 
     return err;
@@ -828,6 +1226,7 @@ int32_t sid_pal_radio_start_tx(uint32_t timeout)
         }
 
         drv_ctx.radio_state = SID_PAL_RADIO_TX;
+        shadow_stats.packets++;
      } while(0);
 
     return err;
@@ -903,6 +1302,7 @@ int32_t sid_pal_radio_start_rx(uint32_t timeout)
             break;
         }
         drv_ctx.radio_state = SID_PAL_RADIO_RX;
+        shadow_stats.packets++;
      } while(0);
 
     return err;
@@ -1109,12 +1509,14 @@ int32_t sid_pal_radio_is_channel_free(uint32_t freq, int16_t threshold, uint32_t
         }
         sid_time_sub(&t_cur, &t_start);
         if (rssi > threshold) {
+            sli_sid_pal_radio_noise_mark_busy(freq, true);
             goto enable_irq;
         }
       // The minimum time needed in between measurements is about 300
       // micro secs.
     } while(sid_time_gt(&t_threshold, &t_cur));
 
+    sli_sid_pal_radio_noise_mark_busy(freq, false);
     *is_channel_free = true;
 
 enable_irq:
@@ -1167,11 +1569,40 @@ int32_t sid_pal_radio_get_cca_level_adjust(sid_pal_radio_data_rate_t data_rate,
     return RADIO_ERROR_NONE;
 }
 
+static int32_t radio_sample_noise(uint32_t freq, int16_t *noise)
+{
+    int32_t err;
+    int32_t sum = 0;
+
+    if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    if ((err = sid_pal_radio_start_continuous_rx()) != RADIO_ERROR_NONE) {
+        return err;
+    }
+
+    for (uint8_t i = 0; i < SX126X_NOISE_SAMPLE_SIZE; i++) {
+        sid_pal_delay_us(SX126X_MIN_CHANNEL_NOISE_DELAY_US);
+        sum += sid_pal_radio_rssi();
+    }
+
+    *noise = (int16_t)(sum / SX126X_NOISE_SAMPLE_SIZE);
+    sli_sid_pal_radio_noise_update(freq, *noise);
+
+    return RADIO_ERROR_NONE;
+}
+
 int32_t sid_pal_radio_get_chan_noise(uint32_t freq, int16_t *noise)
 {
    int32_t err, irq_err;
 
-    if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+    if (sli_sid_pal_radio_noise_get(freq, noise)) {
+        // Leave the radio tuned to the channel in standby as a measurement would
+        if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+            goto ret;
+        }
+        err = sid_pal_radio_standby();
         goto ret;
     }
 
@@ -1179,18 +1610,40 @@ int32_t sid_pal_radio_get_chan_noise(uint32_t freq, int16_t *noise)
         goto ret;
     }
 
-    if ((err = sid_pal_radio_start_continuous_rx()) != RADIO_ERROR_NONE) {
-        goto enable_irq;
+    err = radio_sample_noise(freq, noise);
+
+    // Do not update err on success of the function calls below
+    if ((irq_err = radio_enable_irq()) != RADIO_ERROR_NONE) {
+        err = irq_err;
+        goto ret;
     }
 
-    for (uint8_t i = 0; i < SX126X_NOISE_SAMPLE_SIZE; i++) {
-        sid_pal_delay_us(SX126X_MIN_CHANNEL_NOISE_DELAY_US);
-        *noise += sid_pal_radio_rssi();
+    if ((irq_err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+        err = irq_err;
+    }
+
+ret:
+    return err;
+}
+
+int32_t sli_sid_pal_radio_survey_noise(const uint32_t *freqs, int16_t *noise, uint8_t count)
+{
+    int32_t err, irq_err;
+
+    if ((err = radio_disable_irq()) != RADIO_ERROR_NONE) {
+        goto ret;
     }
 
-    *noise /= SX126X_NOISE_SAMPLE_SIZE;
+    for (uint8_t i = 0; i < count; i++) {
+        // The frequency can only be changed from standby
+        if ((err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+            break;
+        }
+        if ((err = radio_sample_noise(freqs[i], &noise[i])) != RADIO_ERROR_NONE) {
+            break;
+        }
+    }
 
-enable_irq:
     // Do not update err on success of the function calls below
     if ((irq_err = radio_enable_irq()) != RADIO_ERROR_NONE) {
         err = irq_err;
@@ -1231,6 +1684,7 @@ int32_t sid_pal_radio_init(sid_pal_radio_event_notify_t notify, sid_pal_radio_ir
         drv_ctx.report_radio_event = notify;
         drv_ctx.irq_handler = dio_irq_handler;
         drv_ctx.modem = SID_PAL_RADIO_MODEM_MODE_LORA;
+        sli_sid_pal_radio_noise_flush();
 
         sid_pal_radio_set_region(drv_ctx.config->regional_config.radio_region);
 
@@ -1242,6 +1696,7 @@ int32_t sid_pal_radio_init(sid_pal_radio_event_notify_t notify, sid_pal_radio_ir
             break;
         }
 
+        radio_shadow_invalidate(SX126X_SHADOW_ALL);
         if (sx126x_reset(&drv_ctx) != SX126X_STATUS_OK) {
             err = RADIO_ERROR_IO_ERROR;
             break;
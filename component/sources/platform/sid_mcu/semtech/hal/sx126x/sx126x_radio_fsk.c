@@ -88,6 +88,8 @@ int32_t radio_fsk_process_sync_word_detected(halo_drv_semtech_ctx_t *drv_ctx)
                 err = RADIO_ERROR_IO_ERROR;
                 break;;
             }
+            // Payload length no longer matches the packet parameters applied
+            drv_ctx->shadow.valid &= ~SX126X_SHADOW_FSK_PKT_PARAMS;
 
             buffer[RADIO_FSK_SYNC_WORD_VALID_MARKER_OFFSET] = (RADIO_FSK_SYNC_WORD_VALID_MARKER >> 8 & 0xFF);
             buffer[RADIO_FSK_SYNC_WORD_VALID_MARKER_OFFSET + 1] = (RADIO_FSK_SYNC_WORD_VALID_MARKER & 0xFF);
@@ -411,10 +413,15 @@ int32_t sid_pal_radio_set_fsk_packet_params(const sid_pal_radio_fsk_packet_param
 
     sx126x_pkt_params_gfsk_t fsk_pp;
     radio_pp_to_sx126x_pp(&fsk_pp, packet_params);
+    if (sx126x_radio_shadow_has_fsk_pkt_params(&fsk_pp)) {
+        return RADIO_ERROR_NONE;
+    }
+
     if (sx126x_set_gfsk_pkt_params(sx126x_get_drv_ctx(), &fsk_pp) != SX126X_STATUS_OK) {
         return RADIO_ERROR_HARDWARE_ERROR;
     }
 
+    sx126x_radio_shadow_set_fsk_pkt_params(&fsk_pp);
     return RADIO_ERROR_NONE;
 }
 
@@ -215,10 +215,15 @@ int32_t sid_pal_radio_set_lora_modulation_params(const sid_pal_radio_lora_modula
 
     radio_to_sx126x_lora_modulation_params(&lora_mod_params, mod_params);
 
+    if (sx126x_radio_shadow_has_lora_mod_params(&lora_mod_params)) {
+        return RADIO_ERROR_NONE;
+    }
+
     if (sx126x_set_lora_mod_params(sx126x_get_drv_ctx(), &lora_mod_params) != SX126X_STATUS_OK) {
         return RADIO_ERROR_HARDWARE_ERROR;
     }
 
+    sx126x_radio_shadow_set_lora_mod_params(&lora_mod_params);
     return RADIO_ERROR_NONE;
 }
 
@@ -43,6 +43,7 @@
 #include <app_assert.h>
 #include "cmsis_compiler.h"
 #include <stdint.h>
+#include "log_deferred.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -80,6 +81,7 @@ __WEAK void sl_assert_app_callback(uint16_t line_num,
 void sid_pal_assert(int line,
                     const char * file)
 {
+  sli_sid_pal_log_crash_assert(line, file);
   sl_assert_app_callback(line, file);
 
   while (1) {
@@ -97,6 +99,17 @@ __WEAK void sl_assert_app_callback(uint16_t line_num,
   SID_PAL_LOG_ERROR("pal: received a fault! %s @ %d", file_name, line_num);
 }
 
+/*******************************************************************************
+ * Crash ring hook, overridden by log.c. Projects without it still link.
+ * @param line Where the assert happened
+ * @param file Which file was asserted
+ ******************************************************************************/
+__WEAK void sli_sid_pal_log_crash_assert(int line, const char *file)
+{
+  (void)line;
+  (void)file;
+}
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -49,7 +49,7 @@
 
 #include <sid_pal_ble_adapter_ifc.h>
 #include <sid_ble_config_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include "ble_adapter.h"
 #include "sl_bt_api.h"
 #include "sl_bluetooth_config.h"
@@ -58,6 +58,9 @@
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_BLE
+
 #define BLE_NOTIFY_LENGTH                               (2)
 #define BLE_NOTIFICATION_ENABLED                        (1)
 #define BLE_COMPANY_ID_BYTE_LENGTH                      (2)
@@ -41,6 +41,7 @@
 #include <sid_error.h>
 #include <sid_pal_common_ifc.h>
 #include <delay.h>
+#include "log_deferred.h"
 
 #if defined(SV_ENABLED)
 extern void silabs_crypto_enable_sv(void);
@@ -61,6 +62,7 @@ sid_error_t sid_pal_common_init(const platform_specific_init_parameters_t *platf
 
   // Initialise platform-specific & hardware-dependent blocks
   silabs_delay_init();
+  sli_sid_pal_log_init();
 
 #if defined(SV_ENABLED)
   silabs_crypto_enable_sv();
@@ -39,22 +39,30 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 #include <sid_pal_delay_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include <sid_pal_assert_ifc.h>
+#include <sid_pal_critical_region_ifc.h>
 #include <sid_clock_ifc.h>
 #include <sid_time_ops.h>
 #include <sid_time_types.h>
 #include "efr32xgxx_radio.h"
+#include "radio_noise.h"
 
 #include <stdio.h>
+#include <string.h>
 extern void efr32xgxx_radio_irq_process(void);
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_RADIO
+
 #define EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE     (32)
 #define EFR32XGXX_MIN_CHANNEL_FREE_DELAY_US   (1)
 #define EFR32XGXX_MIN_CHANNEL_NOISE_DELAY_US  (30)
+// Same window as the 32 samples 30 us apart the noise used to be sampled with
+#define EFR32XGXX_RADIO_NOISE_AVERAGING_US    (EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE * EFR32XGXX_MIN_CHANNEL_NOISE_DELAY_US)
 #define SIDEWALK_FSK_US_START_FREQUENCY       (902200000)
 #define SIDEWALK_FSK_US_END_FREQUENCY         (916000000)
 // -----------------------------------------------------------------------------
@@ -62,6 +70,9 @@ extern void efr32xgxx_radio_irq_process(void);
 // -----------------------------------------------------------------------------
 static int32_t radio_efr32xgxx_platform_init(void);
 static int32_t radio_efr32xgxx_get_tx_power_range(int8_t *max_tx_power, int8_t *min_tx_power);
+static int32_t radio_efr32xgxx_poll_rssi_above(int16_t threshold, uint32_t delay_us, bool *detected);
+static int32_t radio_efr32xgxx_poll_noise(int16_t *noise);
+static int32_t radio_efr32xgxx_measure_noise(uint32_t freq, int16_t *noise);
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -215,6 +226,7 @@ int32_t sid_pal_radio_sleep(uint32_t sleep_ms)
   }
 
   drv_ctx.radio_state = SID_PAL_RADIO_SLEEP;
+  drv_ctx.shadow.valid = 0;
 
   ret:
   return err;
@@ -268,6 +280,7 @@ int32_t sid_pal_radio_start_tx(uint32_t timeout)
   }
 
   drv_ctx.radio_state = SID_PAL_RADIO_TX;
+  drv_ctx.shadow_stats.packets++;
 
   ret:
   return err;
@@ -291,6 +304,7 @@ int32_t sid_pal_radio_start_rx(uint32_t timeout)
   }
 
   drv_ctx.radio_state = SID_PAL_RADIO_RX;
+  drv_ctx.shadow_stats.packets++;
 
   ret:
   return err;
@@ -340,7 +354,7 @@ int16_t sid_pal_radio_rssi(void)
 int32_t sid_pal_radio_is_channel_free(uint32_t freq, int16_t threshold, uint32_t delay_us, bool *is_channel_free)
 {
   int32_t err = RADIO_ERROR_NONE;
-  int16_t rssi;
+  bool is_busy = false;
 
   *is_channel_free = false;
 
@@ -359,30 +373,20 @@ int32_t sid_pal_radio_is_channel_free(uint32_t freq, int16_t threshold, uint32_t
     delay_us = EFR32XGXX_MIN_CHANNEL_FREE_DELAY_US;
   }
 
-  struct sid_timespec t_start, t_cur, t_threshold;
-
-  t_threshold.tv_sec = delay_us / SID_TIME_USEC_PER_SEC;
-  t_threshold.tv_nsec = (delay_us % SID_TIME_USEC_PER_SEC) * SID_TIME_NSEC_PER_USEC;
-  t_threshold.tv_nsec += ((delay_us % 1000) * 1000);
-
-  if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_start, NULL) != SID_ERROR_NONE) {
-    err = RADIO_ERROR_GENERIC;
+  // The radio raises an event on the first RSSI above the threshold, older
+  // radios without RSSI threshold detection are polled
+  err = efr32xgxx_detect_rssi_above(threshold, delay_us, &is_busy);
+  if (err == RADIO_ERROR_NOT_SUPPORTED) {
+    err = radio_efr32xgxx_poll_rssi_above(threshold, delay_us, &is_busy);
+  }
+  if (err != RADIO_ERROR_NONE) {
     goto ret;
   }
 
-  do {
-    sid_pal_delay_us(EFR32XGXX_MIN_CHANNEL_FREE_DELAY_US);
-    rssi = sid_pal_radio_rssi();
-    if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_cur, NULL) != SID_ERROR_NONE) {
-      err = RADIO_ERROR_GENERIC;
-      goto ret;
-    }
-    sid_time_sub(&t_cur, &t_start);
-    if (rssi > threshold) {
-      goto ret;
-    }
-    // The minimum time needed in between measurements is about 300 micro secs.
-  } while (sid_time_gt(&t_threshold, &t_cur));
+  sli_sid_pal_radio_noise_mark_busy(freq, is_busy);
+  if (is_busy) {
+    goto ret;
+  }
 
   *is_channel_free = true;
 
@@ -443,40 +447,41 @@ int32_t sid_pal_radio_get_cca_level_adjust(sid_pal_radio_data_rate_t data_rate,
 int32_t sid_pal_radio_get_chan_noise(uint32_t freq, int16_t *noise)
 {
   int32_t err = RADIO_ERROR_NONE;
-  int16_t rssi = 0;
 
-  if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
-    err = RADIO_ERROR_HARDWARE_ERROR;
+  if (sli_sid_pal_radio_noise_get(freq, noise)) {
+    // Leave the radio tuned to the channel as a measurement would
+    if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+      err = RADIO_ERROR_HARDWARE_ERROR;
+      goto ret;
+    }
+  } else if ((err = radio_efr32xgxx_measure_noise(freq, noise)) != RADIO_ERROR_NONE) {
     goto ret;
   }
 
-  if ((err = sid_pal_radio_start_continuous_rx()) != RADIO_ERROR_NONE) {
+  if ((err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
     err = RADIO_ERROR_HARDWARE_ERROR;
     goto ret;
   }
 
-  *noise = 0;
+  ret:
+  return err;
+}
 
-  for (uint8_t i = 0; i < EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE; i++) {
-    // Try to acquire valid rssi value
-    sid_pal_delay_us(EFR32XGXX_MIN_CHANNEL_NOISE_DELAY_US);
-    rssi = sid_pal_radio_rssi();
-    if (rssi == INT16_MAX) {
-      // invalid acquisition
-      err = RADIO_ERROR_HARDWARE_ERROR;
-      goto ret;
+int32_t sli_sid_pal_radio_survey_noise(const uint32_t *freqs, int16_t *noise, uint8_t count)
+{
+  int32_t err = RADIO_ERROR_NONE;
+
+  // Every channel leaves the radio idle or receiving, standby once at the end
+  for (uint8_t i = 0; i < count; i++) {
+    if ((err = radio_efr32xgxx_measure_noise(freqs[i], &noise[i])) != RADIO_ERROR_NONE) {
+      break;
     }
-    *noise += rssi;
   }
 
-  *noise /= EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE;
-
-  if ((err = sid_pal_radio_standby()) != RADIO_ERROR_NONE) {
+  if ((sid_pal_radio_standby() != RADIO_ERROR_NONE) && (err == RADIO_ERROR_NONE)) {
     err = RADIO_ERROR_HARDWARE_ERROR;
-    goto ret;
   }
 
-  ret:
   return err;
 }
 
@@ -492,6 +497,8 @@ int32_t sid_pal_radio_set_region(sid_pal_radio_region_code_t region)
   for (uint8_t i = 0; i < drv_ctx.config->regional_config.reg_param_table_size; i++) {
     if (region == drv_ctx.config->regional_config.reg_param_table[i].param_region) {
       drv_ctx.regional_radio_param = drv_ctx.config->regional_config.reg_param_table[i];
+      // The channels of the previous region are meaningless now
+      sli_sid_pal_radio_noise_flush();
       err = RADIO_ERROR_NONE;
       break;
     }
@@ -521,6 +528,8 @@ int32_t sid_pal_radio_init(sid_pal_radio_event_notify_t notify, sid_pal_radio_ir
   drv_ctx.report_radio_event = notify;
   drv_ctx.irq_handler = dio_irq_handler;   // to mimic semtech behaviour
   drv_ctx.modem = SID_PAL_RADIO_MODEM_MODE_FSK;
+  drv_ctx.shadow.valid = 0;
+  sli_sid_pal_radio_noise_flush();
 
   if ((err = sid_pal_radio_set_region(drv_ctx.config->regional_config.radio_region)) != RADIO_ERROR_NONE) {
     err = RADIO_ERROR_HARDWARE_ERROR;
@@ -557,6 +566,20 @@ int32_t sid_pal_radio_deinit(void)
   return RADIO_ERROR_NONE;
 }
 
+void efr32xgxx_get_shadow_stats(efr32xgxx_shadow_stats_t *stats)
+{
+  sid_pal_enter_critical_region();
+  *stats = drv_ctx.shadow_stats;
+  sid_pal_exit_critical_region();
+}
+
+void efr32xgxx_reset_shadow_stats(void)
+{
+  sid_pal_enter_critical_region();
+  memset(&drv_ctx.shadow_stats, 0, sizeof(drv_ctx.shadow_stats));
+  sid_pal_exit_critical_region();
+}
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -584,3 +607,94 @@ static int32_t radio_efr32xgxx_get_tx_power_range(int8_t *max_tx_power, int8_t *
 
   return RADIO_ERROR_NONE;
 }
+
+static int32_t radio_efr32xgxx_poll_rssi_above(int16_t threshold, uint32_t delay_us, bool *detected)
+{
+  int32_t err = RADIO_ERROR_NONE;
+  int16_t rssi;
+  struct sid_timespec t_start, t_cur, t_threshold;
+
+  *detected = false;
+
+  t_threshold.tv_sec = delay_us / SID_TIME_USEC_PER_SEC;
+  t_threshold.tv_nsec = (delay_us % SID_TIME_USEC_PER_SEC) * SID_TIME_NSEC_PER_USEC;
+  t_threshold.tv_nsec += ((delay_us % 1000) * 1000);
+
+  if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_start, NULL) != SID_ERROR_NONE) {
+    err = RADIO_ERROR_GENERIC;
+    goto ret;
+  }
+
+  do {
+    sid_pal_delay_us(EFR32XGXX_MIN_CHANNEL_FREE_DELAY_US);
+    rssi = sid_pal_radio_rssi();
+    if (sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &t_cur, NULL) != SID_ERROR_NONE) {
+      err = RADIO_ERROR_GENERIC;
+      goto ret;
+    }
+    sid_time_sub(&t_cur, &t_start);
+    if (rssi > threshold) {
+      *detected = true;
+      goto ret;
+    }
+    // The minimum time needed in between measurements is about 300 micro secs.
+  } while (sid_time_gt(&t_threshold, &t_cur));
+
+  ret:
+  return err;
+}
+
+static int32_t radio_efr32xgxx_poll_noise(int16_t *noise)
+{
+  int32_t err = RADIO_ERROR_NONE;
+  int16_t rssi = 0;
+  int32_t sum = 0;
+
+  if ((err = sid_pal_radio_start_continuous_rx()) != RADIO_ERROR_NONE) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  for (uint8_t i = 0; i < EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE; i++) {
+    // Try to acquire valid rssi value
+    sid_pal_delay_us(EFR32XGXX_MIN_CHANNEL_NOISE_DELAY_US);
+    rssi = sid_pal_radio_rssi();
+    if (rssi == INT16_MAX) {
+      // invalid acquisition
+      err = RADIO_ERROR_HARDWARE_ERROR;
+      goto ret;
+    }
+    sum += rssi;
+  }
+
+  *noise = (int16_t)(sum / EFR32XGXX_RADIO_NOISE_SAMPLE_SIZE);
+
+  ret:
+  return err;
+}
+
+static int32_t radio_efr32xgxx_measure_noise(uint32_t freq, int16_t *noise)
+{
+  int32_t err = RADIO_ERROR_NONE;
+
+  if ((err = sid_pal_radio_set_frequency(freq)) != RADIO_ERROR_NONE) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  // Averaged by the radio, it receives on the channel by itself. From
+  // interrupt context the samples are polled.
+  err = efr32xgxx_get_rssi_avg(EFR32XGXX_RADIO_NOISE_AVERAGING_US, noise);
+  if (err == RADIO_ERROR_NOT_SUPPORTED) {
+    err = radio_efr32xgxx_poll_noise(noise);
+  }
+  if (err != RADIO_ERROR_NONE) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  sli_sid_pal_radio_noise_update(freq, *noise);
+
+  ret:
+  return err;
+}
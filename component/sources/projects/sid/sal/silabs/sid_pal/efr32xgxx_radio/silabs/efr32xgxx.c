@@ -41,14 +41,28 @@
 #include <stdbool.h>
 #include <sid_clock_ifc.h>
 #include <sid_pal_delay_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include <sid_pal_assert_ifc.h>
+#include "sl_sidewalk_pal_config.h"
 
 #include "silabs/efr32xgxx.h"
 #include "efr32xgxx_radio.h"
+#include "radio_noise.h"
+#include "em_core.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC
+#include <sid_pal_critical_region_ifc.h>
+#include "em_cmu.h"
+#include "em_gpcrc.h"
+#endif
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_RADIO
+
 #define TX_FIFO_SIZE                                (256) // Any power of 2 from [64, 4096] on the EFR32
 #define RF_RANDOM_TIMES                             (8)
 #define RSSI_QUARTER_ORDER                          (2)
@@ -73,6 +87,9 @@
 
 #define EFR32XGXX_SYNCWORD_BYTES                    (8)
 
+// Guard time on top of the averaging time of the hardware RSSI averaging
+#define EFR32XGXX_RSSI_AVERAGE_GUARD_US             (1000)
+
 #define EFR32XGXX_CRC_16_TYPE                       (0)
 #define EFR32XGXX_CRC_32_TYPE                       (1)
 #define EFR32XGXX_CRC_BYTES_ZERO                    (0)
@@ -86,6 +103,15 @@
 
 #define POLYNOMIAL_CRC16                            (0x1021)
 #define POLYNOMIAL_CRC32                            (0x04C11DB7)
+#define CRC16_INIT_VALUE                            (0x0000)
+#define CRC32_INIT_VALUE                            (0xFFFFFFFF)
+
+// RBIT is available from ARMv7-M and ARMv8-M mainline, other cores use a table
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define EFR32XGXX_REVERSE_WITH_RBIT                 (1)
+#else
+#define EFR32XGXX_REVERSE_WITH_RBIT                 (0)
+#endif
 
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 // Greater the priority value, lesser the priority
@@ -107,9 +133,29 @@ static void efr32xgxx_rfready(RAIL_Handle_t rail_handle);
 static void efr32xgxx_event_notify(sid_pal_radio_events_t radio_event);
 static void efr32xgxx_rx_timer_expired(RAIL_Handle_t rail_handle);
 static void efr32xgxx_tx_timer_expired(RAIL_Handle_t rail_handle);
+static void efr32xgxx_rssi_timer_expired(RAIL_MultiTimer_t *timer, RAIL_Time_t expected_time, void *arg);
+static void efr32xgxx_rssi_event_give(void);
+static bool efr32xgxx_rssi_event_can_wait(void);
+static int32_t efr32xgxx_rssi_event_wait(uint32_t timeout_us);
+static void reverse8_buffer(uint8_t *dst, const uint8_t *src, uint16_t length);
+static void efr32xgxx_read_rx_fifo(const RAIL_RxPacketInfo_t *pktinfo,
+                                   uint16_t offset,
+                                   uint8_t *dst,
+                                   uint16_t length,
+                                   bool reverse);
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 static void efr32xgxx_radio_yield(void);
 #endif
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC
+static uint32_t gpcrc_compute(uint32_t polynomial,
+                              uint32_t init_value,
+                              const uint8_t *buffer,
+                              uint16_t length,
+                              uint16_t padded_length);
+#else
+static inline uint32_t crc32_update(uint32_t crc32, uint8_t data);
+static inline uint16_t crc16_update(uint16_t crc16, uint8_t data);
+#endif
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -130,6 +176,10 @@ static bool g_tx_pwr_cfg_init_once = false;
 static bool g_is_first_set_gfsk_mod_params = true;
 static sid_pal_radio_events_t g_last_radio_event = SID_PAL_RADIO_EVENT_UNKNOWN;
 static RAIL_Config_t g_rail_cfg = { .eventsCallback = &radio_irq };
+static SemaphoreHandle_t g_rssi_event = NULL;
+static volatile bool g_rssi_detected = false;
+// Own timer, the RAIL timer may be armed for the rx/tx window meanwhile
+static RAIL_MultiTimer_t g_rssi_guard_timer;
 
 #if defined(SL_SIDEWALK_DMP_SUPPORTED)
 static uint16_t g_prev_channel = 0;
@@ -141,6 +191,123 @@ static RAIL_SchedulerInfo_t g_schedulerInfo = {
 };
 #endif
 
+#if !EFR32XGXX_REVERSE_WITH_RBIT
+static const uint8_t reverse8_table[256] = {
+  0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+  0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+  0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+  0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+  0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+  0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+  0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+  0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+  0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+  0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+  0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+  0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+  0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+  0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+  0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+  0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+};
+#endif
+
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE
+// Indexed by the top nibble of the CRC, a byte takes two lookups
+static const uint32_t crc32_table[16] = {
+  0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
+  0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+  0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
+  0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD
+};
+
+static const uint16_t crc16_table[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+#elif SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BYTE_TABLE
+static const uint32_t crc32_table[256] = {
+  0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B,
+  0x1A864DB2, 0x1E475005, 0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
+  0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD, 0x4C11DB70, 0x48D0C6C7,
+  0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
+  0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3,
+  0x709F7B7A, 0x745E66CD, 0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039,
+  0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5, 0xBE2B5B58, 0xBAEA46EF,
+  0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
+  0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB,
+  0xCEB42022, 0xCA753D95, 0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1,
+  0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D, 0x34867077, 0x30476DC0,
+  0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
+  0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4,
+  0x0808D07D, 0x0CC9CDCA, 0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE,
+  0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02, 0x5E9F46BF, 0x5A5E5B08,
+  0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
+  0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC,
+  0xB6238B25, 0xB2E29692, 0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6,
+  0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A, 0xE0B41DE7, 0xE4750050,
+  0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
+  0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34,
+  0xDC3ABDED, 0xD8FBA05A, 0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637,
+  0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB, 0x4F040D56, 0x4BC510E1,
+  0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
+  0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5,
+  0x3F9B762C, 0x3B5A6B9B, 0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF,
+  0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623, 0xF12F560E, 0xF5EE4BB9,
+  0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
+  0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD,
+  0xCDA1F604, 0xC960EBB3, 0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7,
+  0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B, 0x9B3660C6, 0x9FF77D71,
+  0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
+  0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2,
+  0x470CDD2B, 0x43CDC09C, 0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8,
+  0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24, 0x119B4BE9, 0x155A565E,
+  0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
+  0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A,
+  0x2D15EBE3, 0x29D4F654, 0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0,
+  0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C, 0xE3A1CBC1, 0xE760D676,
+  0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
+  0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662,
+  0x933EB0BB, 0x97FFAD0C, 0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668,
+  0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4
+};
+
+static const uint16_t crc16_table[256] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -150,29 +317,24 @@ uint32_t compute_crc32(const uint8_t *buffer, uint16_t length)
     return 0;
   }
 
-  uint8_t temp_buffer[sizeof(uint32_t)] = { 0 };
-  uint32_t crc32                        = 0xFFFFFFFF;
-  const uint8_t *buffer_local;
-  uint16_t length_local;
+  // Inputs shorter than a word are zero padded to a word
+  uint16_t padded_length = (length < sizeof(uint32_t)) ? sizeof(uint32_t) : length;
 
-  if (length < sizeof(uint32_t)) {
-    memcpy(temp_buffer, buffer, length);
-    length_local = sizeof(uint32_t);
-    buffer_local = temp_buffer;
-  } else {
-    length_local = length;
-    buffer_local = buffer;
-  }
-
-  for (uint16_t index_buffer = 0; index_buffer < length_local; index_buffer++) {
-    crc32 ^= (index_buffer < length) ? ((uint32_t)buffer_local[index_buffer] << 24) : 0x00000000;
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC
+  return ~__RBIT(gpcrc_compute(POLYNOMIAL_CRC32, CRC32_INIT_VALUE, buffer, length, padded_length));
+#else
+  uint32_t crc32 = CRC32_INIT_VALUE;
+  uint16_t index_buffer;
 
-    for (uint8_t i = 0; i < 8; i++) {
-      crc32 = (crc32 & 0x80000000) ? (crc32 << 1) ^ POLYNOMIAL_CRC32 : (crc32 << 1);
-    }
+  for (index_buffer = 0; index_buffer < length; index_buffer++) {
+    crc32 = crc32_update(crc32, buffer[index_buffer]);
+  }
+  for (; index_buffer < padded_length; index_buffer++) {
+    crc32 = crc32_update(crc32, 0x00);
   }
 
   return ~crc32;
+#endif
 }
 
 uint16_t compute_crc16(const uint8_t *buffer, uint16_t length)
@@ -181,17 +343,18 @@ uint16_t compute_crc16(const uint8_t *buffer, uint16_t length)
     return 0;
   }
 
-  uint16_t crc16 = 0x0000;
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC
+  // The 16 bit result is in the low half of DATA, so in the high half once reversed
+  return (uint16_t)(__RBIT(gpcrc_compute(POLYNOMIAL_CRC16, CRC16_INIT_VALUE, buffer, length, length)) >> 16);
+#else
+  uint16_t crc16 = CRC16_INIT_VALUE;
 
   for (uint16_t index_buffer = 0; index_buffer < length; index_buffer++) {
-    crc16 ^= ((uint16_t)buffer[index_buffer] << 8);
-
-    for (uint8_t i = 0; i < 8; i++) {
-      crc16 = (crc16 & 0x8000) ? (crc16 << 1) ^ POLYNOMIAL_CRC16 : (crc16 << 1);
-    }
+    crc16 = crc16_update(crc16, buffer[index_buffer]);
   }
 
   return crc16;
+#endif
 }
 
 void efr32xgxx_event_handler(void)
@@ -210,15 +373,20 @@ void efr32xgxx_radio_irq_process(void)
 
 uint16_t reverse16(uint16_t n)
 {
+#if EFR32XGXX_REVERSE_WITH_RBIT
+  return (uint16_t)(__RBIT(n) >> 16);
+#else
   return (reverse8(n >> 8) | (reverse8(n & 0xff) << 8));
+#endif
 }
 
 uint8_t reverse8(uint8_t n)
 {
-  n = ((0xf0 & n) >> 4) | ((0x0f & n) << 4);
-  n = ((0xcc & n) >> 2) | ((0x33 & n) << 2);
-  n = ((0xaa & n) >> 1) | ((0x55 & n) << 1);
-  return n;
+#if EFR32XGXX_REVERSE_WITH_RBIT
+  return (uint8_t)(__RBIT(n) >> 24);
+#else
+  return reverse8_table[n];
+#endif
 }
 
 uint16_t efr32xgxx_set_phr(uint8_t *hdr, uint8_t modesw, uint8_t crc, uint8_t whitening, uint16_t len)
@@ -287,28 +455,26 @@ uint16_t efr32xgxx_get_rxpacket(uint8_t *phr, uint8_t *payload, int8_t *rssi, bo
     goto ret;
   }
 
-  if (pktinfo.packetBytes <= EFR32XGXX_MAX_PAYLOAD) {
-    uint16_t peek_len = RAIL_PeekRxPacket(g_rail_handle, pktHandle, payload, pktinfo.packetBytes, 0);
-    if (peek_len != pktinfo.packetBytes) {
-      SID_PAL_LOG_ERROR("pal: radio rx pkt len not consistent: %d", peek_len);
-      goto ret;
-    }
+  if (pktinfo.packetBytes > EFR32XGXX_MAX_PAYLOAD) {
+    SID_PAL_LOG_ERROR("pal: radio rx pkt len more than supported: %d", pktinfo.packetBytes);
+    goto ret;
+  }
 
-    memcpy(phr, payload, EFR32XGXX_PHR_LENGTH);
+  if (pktinfo.packetBytes < EFR32XGXX_PHR_LENGTH) {
+    SID_PAL_LOG_ERROR("pal: radio rx pkt shorter than phr: %d", pktinfo.packetBytes);
+    goto ret;
+  }
 
-    if (msb) {
-      for (uint16_t i = 0; i < pktinfo.packetBytes - EFR32XGXX_PHR_LENGTH; i++) {
-        payload[i] = reverse8(payload[i + EFR32XGXX_PHR_LENGTH]);
-      }
-    } else {
-      SID_PAL_LOG_ERROR("pal: radio unsupported endianness");
-      goto ret;
-    }
-  } else {
-    SID_PAL_LOG_ERROR("pal: radio rx pkt len more than supported: %d", pktinfo.packetBytes);
+  if (!msb) {
+    SID_PAL_LOG_ERROR("pal: radio unsupported endianness");
     goto ret;
   }
 
+  // The payload is bit reversed straight from the RAIL FIFO into the rx packet
+  efr32xgxx_read_rx_fifo(&pktinfo, 0, phr, EFR32XGXX_PHR_LENGTH, false);
+  efr32xgxx_read_rx_fifo(&pktinfo, EFR32XGXX_PHR_LENGTH, payload,
+                         pktinfo.packetBytes - EFR32XGXX_PHR_LENGTH, true);
+
   len = reverse16((phr[EFR32XGXX_PHR_LOW_BYTE] << EFR32XGXX_PHR_FIELD_LEN_SHIFT_BITS
                    | phr[EFR32XGXX_PHR_HIGH_BYTE]));
   len = ((len & EFR32XGXX_PHR_FIELD_LEN_HI_MASK) << EFR32XGXX_PHR_FIELD_LEN_SHIFT_BITS)
@@ -446,7 +612,26 @@ int32_t efr32xgxx_set_radio_init(void)
                          | RAIL_EVENT_TX_ABORTED
                          | RAIL_EVENT_TX_BLOCKED
                          | RAIL_EVENT_TX_UNDERFLOW
-                         | RAIL_EVENT_RX_PREAMBLE_DETECT;
+                         | RAIL_EVENT_RX_PREAMBLE_DETECT
+                         | RAIL_EVENT_RSSI_AVERAGE_DONE;
+#if RAIL_SUPPORTS_RSSI_DETECT_THRESHOLD
+  events |= RAIL_EVENT_DETECT_RSSI_THRESHOLD;
+#endif
+
+  if (g_rssi_event == NULL) {
+    g_rssi_event = xSemaphoreCreateBinary();
+    if (g_rssi_event == NULL) {
+      SID_PAL_LOG_ERROR("pal: radio rssi sem create err");
+      err = RADIO_ERROR_NOMEM;
+      goto ret;
+    }
+  }
+
+  if (!RAIL_ConfigMultiTimer(true)) {
+    SID_PAL_LOG_ERROR("pal: radio multitimer cfg err");
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
 
   // Configure radio events
   status = RAIL_ConfigEvents(g_rail_handle, RAIL_EVENTS_ALL, events);
@@ -561,8 +746,9 @@ int32_t efr32xgxx_set_tx_payload(const uint8_t *buffer, uint8_t size, bool msb)
 
   if (msb) {
     memcpy(payload, buffer, EFR32XGXX_PHR_LENGTH);
-    for (uint16_t i = EFR32XGXX_PHR_LENGTH; i < (size - EFR32XGXX_PHR_LENGTH); i++) {
-      payload[i] = reverse8(buffer[i]);
+    if (size > (2 * EFR32XGXX_PHR_LENGTH)) {
+      reverse8_buffer(&payload[EFR32XGXX_PHR_LENGTH], &buffer[EFR32XGXX_PHR_LENGTH],
+                      size - (2 * EFR32XGXX_PHR_LENGTH));
     }
   } else {
     payload = (uint8_t *)buffer;
@@ -703,12 +889,22 @@ int32_t efr32xgxx_set_rf_freq(const uint32_t freq_in_hz)
 int32_t efr32xgxx_set_gfsk_mod_params(const efr32xgxx_mod_params_gfsk_t *params)
 {
   int32_t err = RADIO_ERROR_NONE;
+  halo_drv_silabs_ctx_t *drv_ctx = efr32xgxx_get_drv_ctx();
 
   if (g_is_first_set_gfsk_mod_params) {
     g_is_first_set_gfsk_mod_params = false;
     goto ret;
   }
 
+  // The bit rate selects the RAIL channel config, nothing to do if it is already in use
+  if ((drv_ctx->shadow.valid & EFR32XGXX_SHADOW_FSK_MOD_PARAMS)
+      && (params->br_in_bps == drv_ctx->shadow.br_in_bps)) {
+    drv_ctx->shadow_stats.skipped++;
+    drv_ctx->shadow_stats.saved_reinits++;
+    goto ret;
+  }
+  drv_ctx->shadow.valid &= ~EFR32XGXX_SHADOW_ALL;
+
   if (params->br_in_bps != g_old_br_in_bps) {
     if (params->br_in_bps == RADIO_FSK_BR_50KBPS) {
       g_rf_profile = EFR32XGXX_RAIL_50KBPS_IDX;
@@ -735,6 +931,8 @@ int32_t efr32xgxx_set_gfsk_mod_params(const efr32xgxx_mod_params_gfsk_t *params)
   }
 
   g_old_br_in_bps = params->br_in_bps;
+  drv_ctx->shadow.br_in_bps = params->br_in_bps;
+  drv_ctx->shadow.valid |= EFR32XGXX_SHADOW_FSK_MOD_PARAMS;
 
   ret:
   return err;
@@ -744,14 +942,26 @@ int32_t efr32xgxx_set_gfsk_pkt_params(const efr32xgxx_pkt_params_gfsk_t *params)
 {
   int32_t err = RADIO_ERROR_NONE;
   RAIL_Status_t status;
+  halo_drv_silabs_ctx_t *drv_ctx = efr32xgxx_get_drv_ctx();
+
+  // The preamble length is the only packet parameter given to RAIL
+  if ((drv_ctx->shadow.valid & EFR32XGXX_SHADOW_FSK_PKT_PARAMS)
+      && (params->pbl_len_in_bits == drv_ctx->shadow.pbl_len_in_bits)) {
+    drv_ctx->shadow_stats.skipped++;
+    goto ret;
+  }
 
   status = RAIL_SetTxAltPreambleLength(g_rail_handle, params->pbl_len_in_bits);
   if (status != RAIL_STATUS_NO_ERROR) {
     SID_PAL_LOG_ERROR("pal: radio preamble set err: %d (bits: %d)", status, params->pbl_len_in_bits);
+    drv_ctx->shadow.valid &= ~EFR32XGXX_SHADOW_FSK_PKT_PARAMS;
     err = RADIO_ERROR_HARDWARE_ERROR;
     goto ret;
   }
 
+  drv_ctx->shadow.pbl_len_in_bits = params->pbl_len_in_bits;
+  drv_ctx->shadow.valid |= EFR32XGXX_SHADOW_FSK_PKT_PARAMS;
+
   ret:
   return err;
 }
@@ -800,6 +1010,103 @@ uint32_t efr32xgxx_get_gfsk_time_on_air_in_ms(const efr32xgxx_pkt_params_gfsk_t
   return (numerator + denominator - 1) / denominator;
 }
 
+/**************************************************************************//**
+ * Average the RSSI of the current channel in hardware over averaging_time_us.
+ * The caller sleeps until the radio reports the result. Not supported from
+ * interrupt context or before the scheduler runs, the caller polls then. This
+ * is the case of the stack calls with the SWI interrupt implementation of
+ * SL_SIDEWALK_PAL_SWI_IMPL_METHOD.
+ *****************************************************************************/
+int32_t efr32xgxx_get_rssi_avg(uint32_t averaging_time_us, int16_t *rssi_in_dbm)
+{
+  int32_t err = RADIO_ERROR_NONE;
+  RAIL_Status_t status;
+  int16_t rssi_local;
+
+  if (!efr32xgxx_rssi_event_can_wait()) {
+    return RADIO_ERROR_NOT_SUPPORTED;
+  }
+
+  // Averaging starts from idle, it idles the radio again once done
+  efr32xgxx_set_radio_idle();
+  (void)xSemaphoreTakeFromISR(g_rssi_event, NULL);
+
+#if defined(SL_SIDEWALK_DMP_SUPPORTED)
+  g_schedulerInfo = (RAIL_SchedulerInfo_t) { .priority = EFR32XGXX_RX_PRIORITY };
+  status = RAIL_StartAverageRssi(g_rail_handle, g_channel, averaging_time_us, &g_schedulerInfo);
+#else
+  status = RAIL_StartAverageRssi(g_rail_handle, g_channel, averaging_time_us, NULL);
+#endif
+  if (status != RAIL_STATUS_NO_ERROR) {
+    SID_PAL_LOG_ERROR("pal: radio start avg rssi err: %d", status);
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  err = efr32xgxx_rssi_event_wait(averaging_time_us + EFR32XGXX_RSSI_AVERAGE_GUARD_US);
+  if (err != RADIO_ERROR_NONE) {
+    goto ret;
+  }
+
+  if ((rssi_local = RAIL_GetAverageRssi(g_rail_handle)) == RAIL_RSSI_INVALID) {
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+  *rssi_in_dbm = (rssi_local >> RSSI_QUARTER_ORDER);
+
+  ret:
+  return err;
+}
+
+/**************************************************************************//**
+ * Listen on the current channel for window_us or until the RSSI goes above
+ * threshold. The radio must be receiving, the caller sleeps meanwhile. Not
+ * supported from interrupt context or before the scheduler runs, the caller
+ * polls then, e.g. with the SWI interrupt implementation of
+ * SL_SIDEWALK_PAL_SWI_IMPL_METHOD.
+ *****************************************************************************/
+int32_t efr32xgxx_detect_rssi_above(int16_t threshold, uint32_t window_us, bool *detected)
+{
+#if RAIL_SUPPORTS_RSSI_DETECT_THRESHOLD
+  int32_t err = RADIO_ERROR_NONE;
+  RAIL_Status_t status;
+
+  *detected = false;
+
+  if (!efr32xgxx_rssi_event_can_wait()) {
+    return RADIO_ERROR_NOT_SUPPORTED;
+  }
+
+  if (threshold < INT8_MIN) {
+    threshold = INT8_MIN;
+  } else if (threshold > INT8_MAX) {
+    threshold = INT8_MAX;
+  }
+
+  g_rssi_detected = false;
+  (void)xSemaphoreTakeFromISR(g_rssi_event, NULL);
+
+  status = RAIL_SetRssiDetectThreshold(g_rail_handle, (int8_t)threshold);
+  if (status != RAIL_STATUS_NO_ERROR) {
+    SID_PAL_LOG_ERROR("pal: radio set rssi threshold err: %d", status);
+    err = RADIO_ERROR_HARDWARE_ERROR;
+    goto ret;
+  }
+
+  err = efr32xgxx_rssi_event_wait(window_us);
+  (void)RAIL_SetRssiDetectThreshold(g_rail_handle, RAIL_RSSI_INVALID_DBM);
+  *detected = g_rssi_detected;
+
+  ret:
+  return err;
+#else
+  (void)threshold;
+  (void)window_us;
+  (void)detected;
+  return RADIO_ERROR_NOT_SUPPORTED;
+#endif
+}
+
 int32_t efr32xgxx_get_random_numbers(uint32_t *numbers, unsigned int n)
 {
   int8_t seed, cnt = 0, err_cnt = 0;
@@ -918,6 +1225,7 @@ static void radio_irq(RAIL_Handle_t rail_handle, RAIL_Events_t events)
     halo_drv_silabs_ctx_t *drv_ctx = efr32xgxx_get_drv_ctx();
 
     sid_clock_now(SID_CLOCK_SOURCE_UPTIME, &drv_ctx->radio_rx_packet->rcv_tm, NULL);
+    sli_sid_pal_radio_noise_mark_busy(drv_ctx->radio_freq_hz, true);
     if (radio_fsk_process_rx_done(drv_ctx) == RADIO_ERROR_NONE) {
       memset(&drv_ctx->radio_rx_packet->lora_rx_packet_status, 0, sizeof(sid_pal_radio_lora_rx_packet_status_t));
       efr32xgxx_event_notify(SID_PAL_RADIO_EVENT_RX_DONE);
@@ -988,6 +1296,17 @@ static void radio_irq(RAIL_Handle_t rail_handle, RAIL_Events_t events)
   }
 
   // Perform all calibrations when needed
+#if RAIL_SUPPORTS_RSSI_DETECT_THRESHOLD
+  if (events & RAIL_EVENT_DETECT_RSSI_THRESHOLD) {
+    g_rssi_detected = true;
+    efr32xgxx_rssi_event_give();
+  }
+#endif
+
+  if (events & RAIL_EVENT_RSSI_AVERAGE_DONE) {
+    efr32xgxx_rssi_event_give();
+  }
+
   if (events & RAIL_EVENT_CAL_NEEDED) {
     status = RAIL_Calibrate(rail_handle, NULL, RAIL_CAL_ALL_PENDING);
     if (status != RAIL_STATUS_NO_ERROR) {
@@ -1021,6 +1340,11 @@ static void efr32xgxx_rx_timer_expired(RAIL_Handle_t rail_handle)
       sid_pal_radio_start_tx(0);
       return;
     }
+    // nothing received, what the radio hears is the noise floor
+    int16_t rssi = RAIL_GetRssi(g_rail_handle, false);
+    if (rssi != RAIL_RSSI_INVALID) {
+      sli_sid_pal_radio_noise_sample(drv_ctx->radio_freq_hz, rssi >> RSSI_QUARTER_ORDER);
+    }
     // for standard rx windows, report timeout event
     efr32xgxx_event_notify(SID_PAL_RADIO_EVENT_RX_TIMEOUT);
     // switch radio mode
@@ -1030,3 +1354,183 @@ static void efr32xgxx_rx_timer_expired(RAIL_Handle_t rail_handle)
     // continue rx until RAIL_EVENT_RX_PACKET_RECEIVED event
   }
 }
+
+static void efr32xgxx_rssi_timer_expired(RAIL_MultiTimer_t *timer, RAIL_Time_t expected_time, void *arg)
+{
+  (void)timer;
+  (void)expected_time;
+  (void)arg;
+  efr32xgxx_rssi_event_give();
+}
+
+static void efr32xgxx_rssi_event_give(void)
+{
+  BaseType_t higher_priority_task_woken = pdFALSE;
+
+  xSemaphoreGiveFromISR(g_rssi_event, &higher_priority_task_woken);
+  portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**************************************************************************//**
+ * The RSSI events are waited for by blocking on a semaphore given from the
+ * radio interrupt, which needs a task context with interrupts enabled.
+ *****************************************************************************/
+static bool efr32xgxx_rssi_event_can_wait(void)
+{
+  return !CORE_InIrqContext()
+         && !CORE_IrqIsDisabled()
+         && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+}
+
+/**************************************************************************//**
+ * Wait for an RSSI event of the radio or for timeout_us to elapse. Only to be
+ * called when efr32xgxx_rssi_event_can_wait() is true.
+ *****************************************************************************/
+static int32_t efr32xgxx_rssi_event_wait(uint32_t timeout_us)
+{
+  if (!RAIL_SetMultiTimer(&g_rssi_guard_timer, timeout_us, RAIL_TIME_DELAY, &efr32xgxx_rssi_timer_expired, NULL)) {
+    SID_PAL_LOG_ERROR("pal: radio set rssi tmr err");
+    return RADIO_ERROR_HARDWARE_ERROR;
+  }
+
+  (void)xSemaphoreTake(g_rssi_event, portMAX_DELAY);
+  (void)RAIL_CancelMultiTimer(&g_rssi_guard_timer);
+
+  return RADIO_ERROR_NONE;
+}
+
+/**************************************************************************//**
+ * Reverse the bit order of every byte of src into dst, dst may be src.
+ *****************************************************************************/
+static void reverse8_buffer(uint8_t *dst, const uint8_t *src, uint16_t length)
+{
+  uint16_t i = 0;
+
+#if EFR32XGXX_REVERSE_WITH_RBIT
+  // RBIT reverses the whole word, REV puts the bytes back in their place
+  for (; (i + sizeof(uint32_t)) <= length; i += sizeof(uint32_t)) {
+    uint32_t word;
+
+    memcpy(&word, &src[i], sizeof(word));
+    word = __REV(__RBIT(word));
+    memcpy(&dst[i], &word, sizeof(word));
+  }
+#endif
+
+  for (; i < length; i++) {
+    dst[i] = reverse8(src[i]);
+  }
+}
+
+/**************************************************************************//**
+ * Copy bytes of a received packet out of the RAIL FIFO, the packet may wrap
+ * around the end of the FIFO.
+ *****************************************************************************/
+static void efr32xgxx_read_rx_fifo(const RAIL_RxPacketInfo_t *pktinfo,
+                                   uint16_t offset,
+                                   uint8_t *dst,
+                                   uint16_t length,
+                                   bool reverse)
+{
+  const uint8_t *portion_data[] = { pktinfo->firstPortionData, pktinfo->lastPortionData };
+  uint16_t portion_bytes[] = { pktinfo->firstPortionBytes, pktinfo->packetBytes - pktinfo->firstPortionBytes };
+
+  for (uint8_t i = 0; (i < (sizeof(portion_bytes) / sizeof(portion_bytes[0]))) && (length > 0); i++) {
+    if (offset >= portion_bytes[i]) {
+      offset -= portion_bytes[i];
+      continue;
+    }
+
+    uint16_t chunk = portion_bytes[i] - offset;
+    if (chunk > length) {
+      chunk = length;
+    }
+
+    if (reverse) {
+      reverse8_buffer(dst, &portion_data[i][offset], chunk);
+    } else {
+      memcpy(dst, &portion_data[i][offset], chunk);
+    }
+
+    dst += chunk;
+    length -= chunk;
+    offset = 0;
+  }
+}
+
+#if SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_GPCRC
+static uint32_t gpcrc_compute(uint32_t polynomial,
+                              uint32_t init_value,
+                              const uint8_t *buffer,
+                              uint16_t length,
+                              uint16_t padded_length)
+{
+  GPCRC_Init_TypeDef init = GPCRC_INIT_DEFAULT;
+  uint32_t crc;
+  uint16_t index_buffer;
+
+  // GPCRC shifts LSB first, reversing the input bits gives the MSB first CRC
+  // of the radio in reversed bit order
+  init.crcPoly = polynomial;
+  init.initValue = init_value;
+  init.reverseBits = true;
+
+  CMU_ClockEnable(cmuClock_GPCRC, true);
+
+  sid_pal_enter_critical_region();
+  GPCRC_Init(GPCRC, &init);
+  GPCRC_Start(GPCRC);
+  for (index_buffer = 0; index_buffer < length; index_buffer++) {
+    GPCRC_InputU8(GPCRC, buffer[index_buffer]);
+  }
+  for (; index_buffer < padded_length; index_buffer++) {
+    GPCRC_InputU8(GPCRC, 0x00);
+  }
+  crc = GPCRC_DataRead(GPCRC);
+  sid_pal_exit_critical_region();
+
+  return crc;
+}
+#elif SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_BYTE_TABLE
+static inline uint32_t crc32_update(uint32_t crc32, uint8_t data)
+{
+  return (crc32 << 8) ^ crc32_table[(uint8_t)(crc32 >> 24) ^ data];
+}
+
+static inline uint16_t crc16_update(uint16_t crc16, uint8_t data)
+{
+  return (uint16_t)(crc16 << 8) ^ crc16_table[(uint8_t)(crc16 >> 8) ^ data];
+}
+#elif SL_SIDEWALK_PAL_RADIO_CRC_IMPL == SL_SIDEWALK_PAL_RADIO_CRC_IMPL_NIBBLE_TABLE
+static inline uint32_t crc32_update(uint32_t crc32, uint8_t data)
+{
+  crc32 ^= (uint32_t)data << 24;
+  crc32 = (crc32 << 4) ^ crc32_table[crc32 >> 28];
+  return (crc32 << 4) ^ crc32_table[crc32 >> 28];
+}
+
+static inline uint16_t crc16_update(uint16_t crc16, uint8_t data)
+{
+  crc16 ^= (uint16_t)data << 8;
+  crc16 = (uint16_t)(crc16 << 4) ^ crc16_table[crc16 >> 12];
+  return (uint16_t)(crc16 << 4) ^ crc16_table[crc16 >> 12];
+}
+#else
+static inline uint32_t crc32_update(uint32_t crc32, uint8_t data)
+{
+  crc32 ^= (uint32_t)data << 24;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc32 = (crc32 & 0x80000000) ? (crc32 << 1) ^ POLYNOMIAL_CRC32 : (crc32 << 1);
+  }
+  return crc32;
+}
+
+static inline uint16_t crc16_update(uint16_t crc16, uint8_t data)
+{
+  crc16 ^= (uint16_t)data << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc16 = (crc16 & 0x8000) ? (crc16 << 1) ^ POLYNOMIAL_CRC16 : (crc16 << 1);
+  }
+  return crc16;
+}
+#endif
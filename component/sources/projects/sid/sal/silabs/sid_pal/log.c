@@ -43,6 +43,20 @@
 #include "sid_clock_ifc.h"
 #include "app_log_config.h"   // APP_LOG_ENABLE
 #include "sid_pal_log_ifc.h"  // SID_PAL_LOG_ENABLED
+// Not available to the bare-metal projects, e.g. the PDP provisioner
+#if defined(__has_include)
+  #if __has_include("sl_sidewalk_pal_config.h")
+    #include "sl_sidewalk_pal_config.h"
+  #endif
+#endif
+#include "log_deferred.h"
+
+#ifndef SL_SIDEWALK_PAL_LOG_DEFERRED
+  #define SL_SIDEWALK_PAL_LOG_DEFERRED 0
+#endif
+#ifndef SL_SIDEWALK_PAL_LOG_CRASH_RING
+  #define SL_SIDEWALK_PAL_LOG_CRASH_RING 0
+#endif
 
 #if defined(SID_PAL_LOG_ENABLED) && defined(APP_LOG_ENABLE)
   #if (SID_PAL_LOG_ENABLED != APP_LOG_ENABLE)
@@ -59,16 +73,156 @@
   #include <stdarg.h>
   #pragma message "Please note! The Sidewalk APIs from the file sid_clock_ifc.h might not be backward compatible in the future."
 #endif
+
+#if SID_PAL_LOG_ENABLED && SL_SIDEWALK_PAL_LOG_DEFERRED
+  #define SLI_LOG_DEFERRED 1
+  #include <FreeRTOS.h>
+  #include <task.h>
+#else
+  #define SLI_LOG_DEFERRED 0
+#endif
+
+// The crash ring is kept even if the console log is disabled
+#define SLI_LOG_CRASH_RING  SL_SIDEWALK_PAL_LOG_CRASH_RING
+#define SLI_LOG_RECORDS     (SLI_LOG_DEFERRED || SLI_LOG_CRASH_RING)
+
+#if SLI_LOG_RECORDS
+  #include <stdarg.h>
+  #include <string.h>
+  #include <em_core.h>
+#endif
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 #if SID_PAL_LOG_ENABLED
   #define SLI_LOG_MAX_BUFFER_CHAR (256)
 #endif
+
+#if SLI_LOG_RECORDS
+  #define SLI_LOG_RECORD_MAX_WORDS          (SL_SIDEWALK_PAL_LOG_RECORD_MAX_SIZE / sizeof(uint32_t))
+  // printf flags, width and precision characters, and length modifiers
+  #define SLI_LOG_FORMAT_FLAGS              "-+ #0"
+  #define SLI_LOG_FORMAT_WIDTH              "0123456789.*"
+  #define SLI_LOG_FORMAT_LENGTH             "hljztL"
+  #define SLI_LOG_FORMAT_DOUBLE             "fFeEgGaA"
+#endif
+
+#if SLI_LOG_DEFERRED
+  #define SLI_LOG_RING_WORDS                (SL_SIDEWALK_PAL_LOG_RING_SIZE / sizeof(uint32_t))
+  #define SLI_LOG_DRAIN_TASK_STACK_SIZE     (SL_SIDEWALK_PAL_LOG_DRAIN_TASK_STACK_SIZE / sizeof(configSTACK_DEPTH_TYPE))
+#endif
+
+#if SLI_LOG_CRASH_RING
+  #define SLI_LOG_CRASH_RING_WORDS          (SL_SIDEWALK_PAL_LOG_CRASH_RING_SIZE / sizeof(uint32_t))
+  // Ring of the running firmware, ring of the previous run until the next reset
+  #define SLI_LOG_CRASH_MAGIC_CURRENT       (0x53434C43UL)
+  #define SLI_LOG_CRASH_MAGIC_PREVIOUS      (0x53434C50UL)
+
+// Placed in RAM not initialized at reset, validated at the first use
+typedef struct {
+  uint32_t magic;
+  uint32_t head;
+  uint32_t used;
+  uint32_t words[SLI_LOG_CRASH_RING_WORDS];
+} log_crash_ring_t;
+#endif
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
+#if SLI_LOG_RECORDS
+/*******************************************************************************
+ * Builds a binary record of a log line. Arguments are stored as raw words
+ * following the conversions of the format string, strings are copied.
+ *
+ * @param[out]  record          record words
+ * @param[in]   severity        severity of the log
+ * @param[in]   num_args        number of arguments to be logged
+ * @param[in]   fmt             format string, stored by its address
+ * @param[in]   args            arguments
+ * @returns number of words of the record
+ ******************************************************************************/
+static uint32_t log_record_build(uint32_t *record,
+                                 sid_pal_log_severity_t severity,
+                                 uint32_t num_args,
+                                 const char *fmt,
+                                 va_list *args);
+
+/*******************************************************************************
+ * Stores a record in the enabled rings
+ ******************************************************************************/
+static void log_record_store(uint32_t *record, uint32_t words);
+
+/*******************************************************************************
+ * Prints a record as a hex line for the host side decoder
+ ******************************************************************************/
+static void log_record_print(const uint32_t *record, uint32_t words);
+#endif
 
+#if SLI_LOG_DEFERRED
+/*******************************************************************************
+ * Copies a record into the ring, drops it if the ring is full. Has to be
+ * called in atomic section.
+ *
+ * @returns true if the ring was empty before the record
+ ******************************************************************************/
+static bool log_ring_push(const uint32_t *record, uint32_t words);
+
+/*******************************************************************************
+ * Wakes up the drain task up after a record was stored
+ ******************************************************************************/
+static void log_drain_notify(bool was_empty);
+
+/*******************************************************************************
+ * Takes the oldest record out of the ring if it fits the buffer
+ *
+ * @returns number of words of the record, 0 if there was none
+ ******************************************************************************/
+static uint32_t log_ring_pop(uint32_t *record, uint32_t max_words);
+
+/*******************************************************************************
+ * Prints the records of the ring as hex lines for the host side decoder
+ ******************************************************************************/
+static void log_drain(void);
+
+#if SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+static void log_drain_task(void *context);
+#endif
+#endif
+
+#if SLI_LOG_CRASH_RING
+/*******************************************************************************
+ * Validates the rings found in RAM after reset. The ring of the previous run
+ * is kept for reading, the other one is reset for the current run. Has to be
+ * called in atomic section.
+ ******************************************************************************/
+static void log_crash_ring_restore(void);
+
+/*******************************************************************************
+ * Checks the indexes and the record chain of a ring
+ ******************************************************************************/
+static bool log_crash_ring_is_valid(const log_crash_ring_t *ring);
+
+/*******************************************************************************
+ * Copies a record into the ring of the current run, overwrites the oldest
+ * records if needed. Has to be called in atomic section.
+ ******************************************************************************/
+static void log_crash_ring_push(const uint32_t *record, uint32_t words);
+
+/*******************************************************************************
+ * Copies the record at the given position of the ring of the previous run
+ *
+ * @returns number of words of the record, 0 if there was none or it did not fit
+ ******************************************************************************/
+static uint32_t log_crash_ring_get(uint32_t index, uint32_t *record, uint32_t max_words);
+
+/*******************************************************************************
+ * Builds and stores a record in the crash ring only
+ ******************************************************************************/
+static void log_crash_record(sid_pal_log_severity_t severity,
+                             uint32_t num_args,
+                             const char *fmt,
+                             ...);
+#endif
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -76,13 +230,59 @@
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
+#if SLI_LOG_RECORDS
+static uint16_t log_sequence = 0;
+#endif
 
+#if SLI_LOG_DEFERRED
+static uint32_t log_ring[SLI_LOG_RING_WORDS];
+static uint32_t log_ring_head = 0;
+static uint32_t log_ring_used = 0;
+static uint32_t log_dropped = 0;
+#if SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+static TaskHandle_t log_drain_task_handle = NULL;
+static volatile bool log_drain_notify_pending = false;
+#endif
+#endif
+
+#if SLI_LOG_CRASH_RING
+static log_crash_ring_t log_crash_rings[2] __attribute__((section(SL_SIDEWALK_PAL_LOG_CRASH_RING_SECTION)));
+static log_crash_ring_t *log_crash_ring_current = NULL;
+static log_crash_ring_t *log_crash_ring_previous = NULL;
+#endif
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
 void sid_pal_log_flush(void)
 {
+#if SLI_LOG_DEFERRED
+  log_drain();
+#else
   // Our platform logging functionality does not need flushing
+#endif
+}
+
+void sli_sid_pal_log_init(void)
+{
+#if SLI_LOG_DEFERRED && SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+  if (log_drain_task_handle != NULL) {
+    return;
+  }
+
+  BaseType_t status = xTaskCreate(log_drain_task,
+                                  "sid_log",
+                                  SLI_LOG_DRAIN_TASK_STACK_SIZE,
+                                  NULL,
+                                  SL_SIDEWALK_PAL_LOG_DRAIN_TASK_PRIORITY,
+                                  &log_drain_task_handle);
+  if (status != pdPASS) {
+    // Records stay in the ring until sid_pal_log_flush() or sid_pal_log_get_log_buffer()
+    log_drain_task_handle = NULL;
+    app_log_error("pal: log drain task cannot be created");
+  } else if (log_ring_used > 0) {
+    log_drain_notify_pending = true;
+  }
+#endif
 }
 
 char const *sid_pal_log_push_str(char *string)
@@ -102,7 +302,21 @@ void sid_pal_log(sid_pal_log_severity_t severity,
                  const char * fmt,
                  ...)
 {
-#if SID_PAL_LOG_ENABLED
+#if SLI_LOG_RECORDS
+  uint32_t record[SLI_LOG_RECORD_MAX_WORDS];
+  uint32_t words;
+
+  va_list record_args;
+  va_start(record_args, fmt);
+  words = log_record_build(record, severity, num_args, fmt, &record_args);
+  va_end(record_args);
+
+  log_record_store(record, words);
+#endif
+
+#if SLI_LOG_DEFERRED
+  // Printed by the drain task
+#elif SID_PAL_LOG_ENABLED
   (void)num_args;
   char buffer[SLI_LOG_MAX_BUFFER_CHAR];
 
@@ -131,17 +345,96 @@ void sid_pal_log(sid_pal_log_severity_t severity,
     default:
       break;
   }
-#else
+#elif !SLI_LOG_RECORDS
   (void)severity;
   (void)num_args;
   (void)fmt;
 #endif
 }
 
+/*******************************************************************************
+ * In deferred mode, takes the oldest binary record out of the log ring.
+ * Otherwise with the crash ring, takes the records of the previous run one by
+ * one. The record is decoded by tools/scripts/public/sid_log_decoder, the
+ * buffer has to fit SL_SIDEWALK_PAL_LOG_RECORD_MAX_SIZE bytes.
+ ******************************************************************************/
 bool sid_pal_log_get_log_buffer(struct sid_pal_log_buffer *const log_buffer)
 {
+#if SLI_LOG_RECORDS
+  uint32_t record[SLI_LOG_RECORD_MAX_WORDS];
+  uint32_t max_words;
+  uint32_t words;
+
+  if ((log_buffer == NULL) || (log_buffer->buf == NULL)) {
+    return false;
+  }
+
+  max_words = log_buffer->size / sizeof(uint32_t);
+  if (max_words > SLI_LOG_RECORD_MAX_WORDS) {
+    max_words = SLI_LOG_RECORD_MAX_WORDS;
+  }
+
+#if SLI_LOG_DEFERRED
+  words = log_ring_pop(record, max_words);
+#else
+  words = log_crash_ring_get(0, record, max_words);
+  if (words > 0) {
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_ATOMIC();
+    log_crash_ring_previous->used -= words;
+    CORE_EXIT_ATOMIC();
+  }
+#endif
+  if (words == 0) {
+    return false;
+  }
+
+  memcpy(log_buffer->buf, record, words * sizeof(uint32_t));
+  log_buffer->size = (uint8_t)(words * sizeof(uint32_t));
+  log_buffer->idx = (uint8_t)(record[0] >> SLI_LOG_RECORD_SEQUENCE_SHIFT);
+  return true;
+#else
   (void)log_buffer;
   return false;
+#endif
+}
+
+void sli_sid_pal_log_crash_print(void)
+{
+#if SLI_LOG_CRASH_RING
+  uint32_t record[SLI_LOG_RECORD_MAX_WORDS];
+  uint32_t words;
+
+  for (uint32_t index = 0; (words = log_crash_ring_get(index, record, SLI_LOG_RECORD_MAX_WORDS)) > 0; index++) {
+    log_record_print(record, words);
+  }
+#endif
+}
+
+void sli_sid_pal_log_crash_clear(void)
+{
+#if SLI_LOG_CRASH_RING
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  log_crash_ring_restore();
+  log_crash_ring_previous->head = 0;
+  log_crash_ring_previous->used = 0;
+  CORE_EXIT_ATOMIC();
+#endif
+}
+
+void sli_sid_pal_log_crash_assert(int line, const char *file)
+{
+#if SLI_LOG_CRASH_RING
+  const char *name = (file != NULL) ? strrchr(file, '/') : NULL;
+
+  // The file name only, the start of a long path would be kept otherwise
+  name = (name != NULL) ? (name + 1) : file;
+  log_crash_record(SID_PAL_LOG_SEVERITY_ERROR, 2, "pal: assert %s @ %d", name, line);
+#else
+  (void)line;
+  (void)file;
+#endif
 }
 
 void sid_pal_hexdump(sid_pal_log_severity_t severity, const void *address, int length)
@@ -190,3 +483,389 @@ void _app_log_time()
 {
   app_log_append("[%08lu]" APP_LOG_SEPARATOR, get_time_now());
 }
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+#if SLI_LOG_RECORDS
+static uint32_t log_record_build(uint32_t *record,
+                                 sid_pal_log_severity_t severity,
+                                 uint32_t num_args,
+                                 const char *fmt,
+                                 va_list *args)
+{
+  uint32_t words = SLI_LOG_RECORD_FIXED_WORDS;
+  bool is_truncated = false;
+
+  record[1] = get_time_now();
+  record[2] = (uint32_t)(uintptr_t)fmt;
+
+  for (const char *conv = fmt; (*conv != '\0') && (num_args > 0) && !is_truncated; ) {
+    uint8_t long_count = 0;
+
+    if (*conv++ != '%') {
+      continue;
+    }
+    if (*conv == '%') {
+      conv++;
+      continue;
+    }
+
+    while ((*conv != '\0') && (strchr(SLI_LOG_FORMAT_FLAGS, *conv) != NULL)) {
+      conv++;
+    }
+    // An asterisk width or precision takes an int argument
+    while ((*conv != '\0') && (strchr(SLI_LOG_FORMAT_WIDTH, *conv) != NULL)) {
+      if ((*conv == '*') && (num_args > 0)) {
+        if (words >= SLI_LOG_RECORD_MAX_WORDS) {
+          is_truncated = true;
+          break;
+        }
+        record[words++] = (uint32_t)va_arg(*args, int);
+        num_args--;
+      }
+      conv++;
+    }
+    while ((*conv != '\0') && (strchr(SLI_LOG_FORMAT_LENGTH, *conv) != NULL)) {
+      // intmax_t is 64 bits, count it as ll
+      long_count += (*conv == 'l') ? 1U : ((*conv == 'j') ? 2U : 0U);
+      conv++;
+    }
+    if ((*conv == '\0') || is_truncated || (num_args == 0)) {
+      break;
+    }
+
+    if (*conv == 's') {
+      // Copied, the string may not outlive the call
+      const char *str = va_arg(*args, const char *);
+      uint32_t len = (str != NULL) ? strnlen(str, SL_SIDEWALK_PAL_LOG_STRING_MAX_LEN) : 0U;
+      uint32_t str_words = (len + sizeof(uint32_t) - 1U) / sizeof(uint32_t);
+
+      if ((words + 1U + str_words) > SLI_LOG_RECORD_MAX_WORDS) {
+        is_truncated = true;
+        break;
+      }
+      record[words++] = len;
+      if (str_words > 0) {
+        // Zero padding of the last word
+        record[words + str_words - 1U] = 0;
+        memcpy(&record[words], str, len);
+      }
+      words += str_words;
+    } else if ((strchr(SLI_LOG_FORMAT_DOUBLE, *conv) != NULL) || (long_count >= 2U)) {
+      uint64_t value;
+
+      if ((words + 2U) > SLI_LOG_RECORD_MAX_WORDS) {
+        is_truncated = true;
+        break;
+      }
+      if (long_count >= 2U) {
+        value = va_arg(*args, uint64_t);
+      } else {
+        double dvalue = va_arg(*args, double);
+        memcpy(&value, &dvalue, sizeof(value));
+      }
+      record[words++] = (uint32_t)value;
+      record[words++] = (uint32_t)(value >> 32);
+    } else {
+      // Integers, characters and pointers are all 32 bits wide
+      if (words >= SLI_LOG_RECORD_MAX_WORDS) {
+        is_truncated = true;
+        break;
+      }
+      record[words++] = va_arg(*args, uint32_t);
+    }
+    conv++;
+    num_args--;
+  }
+
+  record[0] = words
+              | (((uint32_t)severity & SLI_LOG_RECORD_SEVERITY_MASK) << SLI_LOG_RECORD_SEVERITY_SHIFT)
+              | (is_truncated ? SLI_LOG_RECORD_TRUNCATED : 0U);
+
+  return words;
+}
+
+static void log_record_store(uint32_t *record, uint32_t words)
+{
+#if SLI_LOG_DEFERRED
+  bool was_empty;
+#endif
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  // Sequence numbers of dropped records are skipped, the decoder sees the gap
+  record[0] |= (uint32_t)log_sequence << SLI_LOG_RECORD_SEQUENCE_SHIFT;
+  log_sequence++;
+#if SLI_LOG_CRASH_RING
+  if (((record[0] >> SLI_LOG_RECORD_SEVERITY_SHIFT) & SLI_LOG_RECORD_SEVERITY_MASK) <= SL_SIDEWALK_PAL_LOG_CRASH_RING_LEVEL) {
+    log_crash_ring_push(record, words);
+  }
+#endif
+#if SLI_LOG_DEFERRED
+  was_empty = log_ring_push(record, words);
+#endif
+  CORE_EXIT_ATOMIC();
+
+#if SLI_LOG_DEFERRED
+  log_drain_notify(was_empty);
+#endif
+}
+
+static void log_record_print(const uint32_t *record, uint32_t words)
+{
+  app_log_append(SLI_LOG_RECORD_LINE_PREFIX);
+  for (uint32_t i = 0; i < words; i++) {
+    app_log_append("%08lx", (unsigned long)record[i]);
+  }
+  app_log_append(APP_LOG_NEW_LINE);
+}
+#endif
+
+#if SLI_LOG_DEFERRED
+static bool log_ring_push(const uint32_t *record, uint32_t words)
+{
+  bool was_empty = (log_ring_used == 0);
+
+  if ((SLI_LOG_RING_WORDS - log_ring_used) < words) {
+    log_dropped++;
+    // Nothing stored, no need to wake up the drain task
+    return false;
+  }
+
+  uint32_t index = log_ring_head;
+  for (uint32_t i = 0; i < words; i++) {
+    log_ring[index] = record[i];
+    index = (index + 1U < SLI_LOG_RING_WORDS) ? (index + 1U) : 0U;
+  }
+  log_ring_head = index;
+  log_ring_used += words;
+
+  return was_empty;
+}
+
+static void log_drain_notify(bool was_empty)
+{
+#if SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+  if (log_drain_task_handle == NULL) {
+    return;
+  }
+  if (!was_empty && !log_drain_notify_pending) {
+    // Already notified
+    return;
+  }
+
+  // Notifying from a critical section of the caller would end it
+  if (CORE_IrqIsDisabled() || (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)) {
+    log_drain_notify_pending = true;
+    return;
+  }
+
+  log_drain_notify_pending = false;
+  if (CORE_InIrqContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(log_drain_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+  } else {
+    (void)xTaskNotifyGive(log_drain_task_handle);
+  }
+#else
+  (void)was_empty;
+#endif
+}
+
+static uint32_t log_ring_pop(uint32_t *record, uint32_t max_words)
+{
+  uint32_t words = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (log_ring_used > 0) {
+    uint32_t index = (log_ring_head + SLI_LOG_RING_WORDS - log_ring_used) % SLI_LOG_RING_WORDS;
+    uint32_t length = log_ring[index] & SLI_LOG_RECORD_LENGTH_MASK;
+
+    if (length <= max_words) {
+      for (uint32_t i = 0; i < length; i++) {
+        record[i] = log_ring[index];
+        index = (index + 1U < SLI_LOG_RING_WORDS) ? (index + 1U) : 0U;
+      }
+      log_ring_used -= length;
+      words = length;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return words;
+}
+
+static void log_drain(void)
+{
+  uint32_t record[SLI_LOG_RECORD_MAX_WORDS];
+  uint32_t words;
+  uint32_t dropped;
+
+  while ((words = log_ring_pop(record, SLI_LOG_RECORD_MAX_WORDS)) > 0) {
+    log_record_print(record, words);
+  }
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  dropped = log_dropped;
+  log_dropped = 0;
+  CORE_EXIT_ATOMIC();
+
+  if (dropped > 0) {
+    app_log_warning("pal: %lu log records dropped", (unsigned long)dropped);
+  }
+}
+
+#if SL_SIDEWALK_PAL_LOG_DRAIN_TASK
+static void log_drain_task(void *context)
+{
+  (void)context;
+
+  while (1) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    log_drain();
+  }
+}
+#endif
+#endif
+
+#if SLI_LOG_CRASH_RING
+static void log_crash_ring_restore(void)
+{
+  log_crash_ring_t *last_run = NULL;
+
+  if (log_crash_ring_current != NULL) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < 2; i++) {
+    if ((log_crash_rings[i].magic == SLI_LOG_CRASH_MAGIC_CURRENT) && log_crash_ring_is_valid(&log_crash_rings[i])) {
+      last_run = &log_crash_rings[i];
+      break;
+    }
+  }
+
+  if (last_run != NULL) {
+    log_crash_ring_previous = last_run;
+    log_crash_ring_current = (last_run == &log_crash_rings[0]) ? &log_crash_rings[1] : &log_crash_rings[0];
+  } else {
+    // Power on reset or corrupted
+    log_crash_ring_previous = &log_crash_rings[1];
+    log_crash_ring_previous->head = 0;
+    log_crash_ring_previous->used = 0;
+    log_crash_ring_current = &log_crash_rings[0];
+  }
+  log_crash_ring_previous->magic = SLI_LOG_CRASH_MAGIC_PREVIOUS;
+  log_crash_ring_current->head = 0;
+  log_crash_ring_current->used = 0;
+  log_crash_ring_current->magic = SLI_LOG_CRASH_MAGIC_CURRENT;
+}
+
+static bool log_crash_ring_is_valid(const log_crash_ring_t *ring)
+{
+  uint32_t index;
+  uint32_t remaining;
+
+  if ((ring->head >= SLI_LOG_CRASH_RING_WORDS) || (ring->used > SLI_LOG_CRASH_RING_WORDS)) {
+    return false;
+  }
+
+  index = (ring->head + SLI_LOG_CRASH_RING_WORDS - ring->used) % SLI_LOG_CRASH_RING_WORDS;
+  remaining = ring->used;
+  while (remaining > 0) {
+    uint32_t length = ring->words[index] & SLI_LOG_RECORD_LENGTH_MASK;
+
+    if ((length < SLI_LOG_RECORD_FIXED_WORDS) || (length > remaining)) {
+      return false;
+    }
+    index = (index + length) % SLI_LOG_CRASH_RING_WORDS;
+    remaining -= length;
+  }
+
+  return true;
+}
+
+static void log_crash_ring_push(const uint32_t *record, uint32_t words)
+{
+  log_crash_ring_restore();
+
+  log_crash_ring_t *ring = log_crash_ring_current;
+  if (words > SLI_LOG_CRASH_RING_WORDS) {
+    return;
+  }
+
+  // Makes room by dropping the oldest records
+  while ((SLI_LOG_CRASH_RING_WORDS - ring->used) < words) {
+    uint32_t tail = (ring->head + SLI_LOG_CRASH_RING_WORDS - ring->used) % SLI_LOG_CRASH_RING_WORDS;
+    ring->used -= ring->words[tail] & SLI_LOG_RECORD_LENGTH_MASK;
+  }
+
+  uint32_t index = ring->head;
+  for (uint32_t i = 0; i < words; i++) {
+    ring->words[index] = record[i];
+    index = (index + 1U < SLI_LOG_CRASH_RING_WORDS) ? (index + 1U) : 0U;
+  }
+  // Indexes last, a reset in between leaves a valid ring
+  ring->head = index;
+  ring->used += words;
+}
+
+static uint32_t log_crash_ring_get(uint32_t index, uint32_t *record, uint32_t max_words)
+{
+  uint32_t words = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  log_crash_ring_restore();
+
+  log_crash_ring_t *ring = log_crash_ring_previous;
+  uint32_t position = (ring->head + SLI_LOG_CRASH_RING_WORDS - ring->used) % SLI_LOG_CRASH_RING_WORDS;
+  uint32_t remaining = ring->used;
+  uint32_t length = 0;
+
+  while (remaining > 0) {
+    length = ring->words[position] & SLI_LOG_RECORD_LENGTH_MASK;
+    if (index == 0) {
+      break;
+    }
+    position = (position + length) % SLI_LOG_CRASH_RING_WORDS;
+    remaining -= length;
+    index--;
+  }
+
+  if ((remaining > 0) && (length <= max_words)) {
+    for (uint32_t i = 0; i < length; i++) {
+      record[i] = ring->words[position];
+      position = (position + 1U < SLI_LOG_CRASH_RING_WORDS) ? (position + 1U) : 0U;
+    }
+    words = length;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return words;
+}
+
+static void log_crash_record(sid_pal_log_severity_t severity,
+                             uint32_t num_args,
+                             const char *fmt,
+                             ...)
+{
+  uint32_t record[SLI_LOG_RECORD_MAX_WORDS];
+  uint32_t words;
+
+  va_list args;
+  va_start(args, fmt);
+  words = log_record_build(record, severity, num_args, fmt, &args);
+  va_end(args);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  record[0] |= (uint32_t)log_sequence << SLI_LOG_RECORD_SEQUENCE_SHIFT;
+  log_sequence++;
+  log_crash_ring_push(record, words);
+  CORE_EXIT_ATOMIC();
+}
+#endif
@@ -40,7 +40,7 @@
 // -----------------------------------------------------------------------------
 
 #include <sid_pal_mfg_store_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include <stdalign.h>
 #include <stdint.h>
 #include <string.h>
@@ -60,6 +60,8 @@
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE
+
 #define MFG_VERSION_1_VAL                   0x01000000
 #define MFG_VERSION_2_VAL                   0x2
 
@@ -115,6 +117,8 @@ void sid_pal_mfg_store_init(sid_pal_mfg_store_region_t mfg_store_region)
     }
   }
 
+  sli_sid_nvm3_repack_init();
+
   uint16_t obj_cnt = (uint16_t)nvm3_enumObjects(nvm3_defaultHandle, NULL, 0, SLI_SID_NVM3_KEY_MIN_MFG, SLI_SID_NVM3_KEY_MAX_MFG);
   SID_PAL_LOG_INFO("pal: mfg store opened with %d object(s)", obj_cnt);
 }
@@ -143,12 +147,10 @@ int32_t sid_pal_mfg_store_write(uint16_t value, const uint8_t *buffer, uint16_t
     return MFG_STORE_ERROR_ST_WRITE_ERROR;
   }
 
-  if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-    status = nvm3_repack(nvm3_defaultHandle);
-    if (status != ECODE_NVM3_OK) {
-      SID_PAL_LOG_ERROR("pal: mfg write, repack err: %d", status);
-      return MFG_STORE_ERROR_ST_REPACK_ERROR;
-    }
+  status = sli_sid_nvm3_repack_request();
+  if (status != ECODE_NVM3_OK) {
+    SID_PAL_LOG_ERROR("pal: mfg write, repack err: %d", status);
+    return MFG_STORE_ERROR_ST_REPACK_ERROR;
   }
 
   return MFG_STORE_ERROR_ST_SUCCESS;
@@ -39,16 +39,47 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 
+#include <string.h>
+#include "log_module.h"
 #include "nvm3_manager.h"
+#include "sl_sleeptimer.h"
+#include "sl_component_catalog.h"
+// Not available to the bare-metal projects, e.g. the PDP provisioner
+#if defined(__has_include)
+#if __has_include("sl_sidewalk_pal_config.h")
+#include "sl_sidewalk_pal_config.h"
+#endif
+#endif
+
+#ifndef SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK
+#define SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK 0
+#endif
+
+// The repack task needs the kernel, repacks stay inline without it
+#if SL_SIDEWALK_PAL_NVM3_DEFERRED_REPACK && defined(SL_CATALOG_FREERTOS_KERNEL_PRESENT)
+#define SLI_NVM3_DEFERRED_REPACK 1
+#include <FreeRTOS.h>
+#include <task.h>
+#else
+#define SLI_NVM3_DEFERRED_REPACK 0
+#endif
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE
+
+#if SLI_NVM3_DEFERRED_REPACK
+#define REPACK_TASK_STACK_SIZE    (SL_SIDEWALK_PAL_NVM3_REPACK_TASK_STACK_SIZE / sizeof(configSTACK_DEPTH_TYPE))
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+static Ecode_t repack_step(void);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -57,10 +88,57 @@
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static sli_sid_nvm3_repack_stats_t repack_stats;
+#if SLI_NVM3_DEFERRED_REPACK
+static TaskHandle_t repack_task_handle = NULL;
+static volatile bool repack_pending = false;
+static volatile TickType_t repack_pending_since = 0;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
+static Ecode_t repack_step(void)
+{
+  uint32_t start = sl_sleeptimer_get_tick_count();
+  Ecode_t status = nvm3_repack(nvm3_defaultHandle);
+  uint32_t duration_ms = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count() - start);
+
+  repack_stats.repack_count++;
+  repack_stats.last_duration_ms = duration_ms;
+  repack_stats.total_duration_ms += duration_ms;
+  if (duration_ms > repack_stats.max_duration_ms) {
+    repack_stats.max_duration_ms = duration_ms;
+  }
+  if (status != ECODE_NVM3_OK) {
+    repack_stats.repack_errors++;
+  }
+
+  return status;
+}
+
+#if SLI_NVM3_DEFERRED_REPACK
+static void repack_task(void *context)
+{
+  (void)context;
+
+  while (1) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // nvm3_repack() does a bounded step, give way to other tasks in between
+    while (nvm3_repackNeeded(nvm3_defaultHandle)) {
+      if (repack_step() != ECODE_NVM3_OK) {
+        SID_PAL_LOG_ERROR("pal: nvm3 deferred repack err");
+        break;
+      }
+      taskYIELD();
+    }
+    repack_pending = false;
+  }
+}
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -106,3 +184,62 @@ sid_error_t sli_sid_nvm3_convert_ecode_to_sid_error(Ecode_t nvm3_return_code)
 
   return sid_error_code;
 }
+
+void sli_sid_nvm3_repack_init(void)
+{
+#if SLI_NVM3_DEFERRED_REPACK
+  if (repack_task_handle != NULL) {
+    return;
+  }
+
+  BaseType_t status = xTaskCreate(repack_task,
+                                  "nvm3_repack",
+                                  REPACK_TASK_STACK_SIZE,
+                                  NULL,
+                                  SL_SIDEWALK_PAL_NVM3_REPACK_TASK_PRIORITY,
+                                  &repack_task_handle);
+  if (status != pdPASS) {
+    // Repacks stay inline
+    repack_task_handle = NULL;
+    SID_PAL_LOG_ERROR("pal: nvm3 repack task cannot be created");
+  }
+#endif
+}
+
+Ecode_t sli_sid_nvm3_repack_request(void)
+{
+  if (!nvm3_repackNeeded(nvm3_defaultHandle)) {
+    return ECODE_NVM3_OK;
+  }
+
+  repack_stats.requests++;
+
+#if SLI_NVM3_DEFERRED_REPACK
+  if ((repack_task_handle != NULL) && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) {
+    TickType_t now = xTaskGetTickCount();
+
+    if (!repack_pending) {
+      repack_pending_since = now;
+      repack_pending = true;
+    }
+
+    if ((now - repack_pending_since) < pdMS_TO_TICKS(SL_SIDEWALK_PAL_NVM3_REPACK_DEADLINE_MS)) {
+      repack_stats.stalls_avoided++;
+      xTaskNotifyGive(repack_task_handle);
+      return ECODE_NVM3_OK;
+    }
+
+    // The repack task did not get CPU time, do not let the free space run out
+    repack_stats.deadline_repacks++;
+  }
+#endif
+
+  return repack_step();
+}
+
+void sli_sid_nvm3_get_repack_stats(sli_sid_nvm3_repack_stats_t *stats)
+{
+  if (stats != NULL) {
+    memcpy(stats, &repack_stats, sizeof(repack_stats));
+  }
+}
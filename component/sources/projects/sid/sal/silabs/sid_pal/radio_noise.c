@@ -0,0 +1,294 @@
+/***************************************************************************//**
+ * @file
+ * @brief radio_noise.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+#include <sid_pal_uptime_ifc.h>
+#include <sid_pal_critical_region_ifc.h>
+#include <sid_time_types.h>
+#include "sl_sidewalk_pal_config.h"
+#include "radio_noise.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// Weight of a new noise sample of a fresh entry, 1 / 2^shift
+#define RADIO_NOISE_SMOOTHING_SHIFT   (2)
+// Weight of a new occupancy observation, 1 / 2^shift
+#define RADIO_NOISE_OCCUPANCY_SHIFT   (3)
+#define RADIO_NOISE_OCCUPANCY_BUSY    (100)
+// Invalid RSSI reported by sid_pal_radio_rssi()
+#define RADIO_NOISE_INVALID_RSSI      (INT16_MAX)
+
+#if SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE > 0
+#define RADIO_NOISE_TABLE_SLOTS       (SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE)
+#else
+#define RADIO_NOISE_TABLE_SLOTS       (1)
+#endif
+
+typedef struct {
+  uint32_t freq;                // 0 for an unused slot
+  uint32_t noise_ms;            // uptime of the last noise sample
+  uint32_t last_use_ms;         // uptime of the last update, oldest is replaced
+  int16_t noise;
+  uint8_t occupancy;
+  bool has_noise;
+  bool has_occupancy;
+} radio_noise_slot_t;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Uptime in milliseconds, wraps around
+ ******************************************************************************/
+static uint32_t radio_noise_now_ms(void);
+
+/*******************************************************************************
+ * Looks a channel up, has to be called in critical region
+ ******************************************************************************/
+static radio_noise_slot_t *radio_noise_find(uint32_t freq);
+
+/*******************************************************************************
+ * Looks a channel up, takes the least recently updated slot if not found.
+ * Has to be called in critical region.
+ ******************************************************************************/
+static radio_noise_slot_t *radio_noise_find_or_add(uint32_t freq, uint32_t now_ms);
+
+static bool radio_noise_is_fresh(const radio_noise_slot_t *slot, uint32_t now_ms);
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static radio_noise_slot_t noise_table[RADIO_NOISE_TABLE_SLOTS];
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+void sli_sid_pal_radio_noise_update(uint32_t freq, int16_t rssi)
+{
+  if ((SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE == 0) || (freq == 0) || (rssi == RADIO_NOISE_INVALID_RSSI)) {
+    return;
+  }
+
+  uint32_t now_ms = radio_noise_now_ms();
+
+  sid_pal_enter_critical_region();
+  radio_noise_slot_t *slot = radio_noise_find_or_add(freq, now_ms);
+  if (radio_noise_is_fresh(slot, now_ms)) {
+    slot->noise += (rssi - slot->noise) / (1 << RADIO_NOISE_SMOOTHING_SHIFT);
+  } else {
+    slot->noise = rssi;
+  }
+  slot->has_noise = true;
+  slot->noise_ms = now_ms;
+  slot->last_use_ms = now_ms;
+  sid_pal_exit_critical_region();
+}
+
+void sli_sid_pal_radio_noise_sample(uint32_t freq, int16_t rssi)
+{
+  if ((SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE == 0) || (freq == 0) || (rssi == RADIO_NOISE_INVALID_RSSI)) {
+    return;
+  }
+
+  uint32_t now_ms = radio_noise_now_ms();
+
+  sid_pal_enter_critical_region();
+  radio_noise_slot_t *slot = radio_noise_find(freq);
+  if ((slot != NULL) && radio_noise_is_fresh(slot, now_ms)) {
+    slot->noise += (rssi - slot->noise) / (1 << RADIO_NOISE_SMOOTHING_SHIFT);
+    slot->last_use_ms = now_ms;
+  }
+  sid_pal_exit_critical_region();
+}
+
+void sli_sid_pal_radio_noise_mark_busy(uint32_t freq, bool busy)
+{
+  if ((SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE == 0) || (freq == 0)) {
+    return;
+  }
+
+  uint32_t now_ms = radio_noise_now_ms();
+  int16_t target = busy ? RADIO_NOISE_OCCUPANCY_BUSY : 0;
+
+  sid_pal_enter_critical_region();
+  radio_noise_slot_t *slot = radio_noise_find_or_add(freq, now_ms);
+  if (slot->has_occupancy) {
+    // Rounded away from zero to reach 0 % and 100 %
+    int16_t delta = target - slot->occupancy;
+    int16_t round = (1 << RADIO_NOISE_OCCUPANCY_SHIFT) - 1;
+    slot->occupancy += (delta + ((delta > 0) ? round : -round)) / (1 << RADIO_NOISE_OCCUPANCY_SHIFT);
+  } else {
+    slot->occupancy = (uint8_t)target;
+    slot->has_occupancy = true;
+  }
+  slot->last_use_ms = now_ms;
+  sid_pal_exit_critical_region();
+}
+
+bool sli_sid_pal_radio_noise_get(uint32_t freq, int16_t *noise)
+{
+  bool found = false;
+  uint32_t now_ms = radio_noise_now_ms();
+
+  if (SL_SIDEWALK_PAL_RADIO_NOISE_MAX_AGE_MS == 0) {
+    return false;
+  }
+
+  sid_pal_enter_critical_region();
+  const radio_noise_slot_t *slot = radio_noise_find(freq);
+  if ((slot != NULL) && radio_noise_is_fresh(slot, now_ms)) {
+    *noise = slot->noise;
+    found = true;
+  }
+  sid_pal_exit_critical_region();
+
+  return found;
+}
+
+bool sli_sid_pal_radio_noise_get_entry(uint32_t freq, sli_sid_pal_radio_noise_entry_t *entry)
+{
+  bool found = false;
+  uint32_t now_ms = radio_noise_now_ms();
+
+  sid_pal_enter_critical_region();
+  const radio_noise_slot_t *slot = radio_noise_find(freq);
+  if (slot != NULL) {
+    entry->freq = slot->freq;
+    entry->noise = slot->noise;
+    entry->occupancy = slot->occupancy;
+    entry->noise_age_ms = slot->has_noise ? (now_ms - slot->noise_ms) : UINT32_MAX;
+    found = true;
+  }
+  sid_pal_exit_critical_region();
+
+  return found;
+}
+
+uint8_t sli_sid_pal_radio_noise_quietest(const uint32_t *freqs, uint8_t count)
+{
+  uint8_t quietest = count;
+  int16_t quietest_noise = INT16_MAX;
+  uint8_t quietest_occupancy = UINT8_MAX;
+  uint32_t now_ms = radio_noise_now_ms();
+
+  sid_pal_enter_critical_region();
+  for (uint8_t i = 0; i < count; i++) {
+    const radio_noise_slot_t *slot = radio_noise_find(freqs[i]);
+    if ((slot == NULL) || !radio_noise_is_fresh(slot, now_ms)) {
+      continue;
+    }
+    if ((slot->noise < quietest_noise)
+        || ((slot->noise == quietest_noise) && (slot->occupancy < quietest_occupancy))) {
+      quietest = i;
+      quietest_noise = slot->noise;
+      quietest_occupancy = slot->occupancy;
+    }
+  }
+  sid_pal_exit_critical_region();
+
+  return quietest;
+}
+
+void sli_sid_pal_radio_noise_flush(void)
+{
+  sid_pal_enter_critical_region();
+  memset(noise_table, 0, sizeof(noise_table));
+  sid_pal_exit_critical_region();
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static uint32_t radio_noise_now_ms(void)
+{
+  struct sid_timespec now = { 0 };
+
+  (void)sid_pal_uptime_now(&now);
+
+  return (uint32_t)((now.tv_sec * SID_TIME_MSEC_PER_SEC) + (now.tv_nsec / SID_TIME_NSEC_PER_MSEC));
+}
+
+static radio_noise_slot_t *radio_noise_find(uint32_t freq)
+{
+  if ((SL_SIDEWALK_PAL_RADIO_NOISE_TABLE_SIZE == 0) || (freq == 0)) {
+    return NULL;
+  }
+
+  for (uint8_t i = 0; i < RADIO_NOISE_TABLE_SLOTS; i++) {
+    if (noise_table[i].freq == freq) {
+      return &noise_table[i];
+    }
+  }
+
+  return NULL;
+}
+
+static radio_noise_slot_t *radio_noise_find_or_add(uint32_t freq, uint32_t now_ms)
+{
+  radio_noise_slot_t *slot = radio_noise_find(freq);
+
+  if (slot != NULL) {
+    return slot;
+  }
+
+  slot = &noise_table[0];
+  for (uint8_t i = 0; i < RADIO_NOISE_TABLE_SLOTS; i++) {
+    if (noise_table[i].freq == 0) {
+      slot = &noise_table[i];
+      break;
+    }
+    if ((now_ms - noise_table[i].last_use_ms) > (now_ms - slot->last_use_ms)) {
+      slot = &noise_table[i];
+    }
+  }
+
+  memset(slot, 0, sizeof(*slot));
+  slot->freq = freq;
+
+  return slot;
+}
+
+static bool radio_noise_is_fresh(const radio_noise_slot_t *slot, uint32_t now_ms)
+{
+  return slot->has_noise && ((now_ms - slot->noise_ms) <= SL_SIDEWALK_PAL_RADIO_NOISE_MAX_AGE_MS);
+}
@@ -48,6 +48,8 @@
 #include <em_usart.h>
 #include <gpio.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
@@ -66,8 +68,18 @@
 struct serial_bus_efr32_spi_ctx {
   struct sid_pal_serial_bus_iface iface;
   struct sid_pal_serial_bus_efr32_spi_config config;
+  // Asynchronous transfer in flight
+  volatile bool xfer_pending;
+  const struct sid_pal_serial_bus_client *xfer_client;
+  sid_pal_serial_bus_efr32_spi_xfer_done_t xfer_done;
+  void *xfer_arg;
 };
 
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static struct serial_bus_efr32_spi_ctx bus = { 0 };
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
@@ -81,17 +93,45 @@ static sid_error_t bus_serial_spi_xfer(const struct sid_pal_serial_bus_iface *if
     return SID_ERROR_INVALID_ARGS;
   }
 
-  struct serial_bus_efr32_spi_ctx *bus = SLI_CONTAINEROF(iface, struct serial_bus_efr32_spi_ctx, iface);
+  struct serial_bus_efr32_spi_ctx *ctx = SLI_CONTAINEROF(iface, struct serial_bus_efr32_spi_ctx, iface);
+  sid_error_t err = SID_ERROR_NONE;
+
+  if (ctx->xfer_pending) {
+    return SID_ERROR_BUSY;
+  }
 
   sid_pal_gpio_write(client->client_selector, 0);
 
-  for (size_t i = 0; i < xfer_size; i++) {
-    rx[i] = (uint8_t)USART_SpiTransfer(bus->config.peripheral_id, tx[i]);
+  if (ctx->config.spidrv_handle != NULL) {
+    // Bytes are clocked back to back by the DMA instead of one by one
+    if (SPIDRV_MTransferB(*ctx->config.spidrv_handle, tx, rx, (int)xfer_size) != ECODE_EMDRV_SPIDRV_OK) {
+      err = SID_ERROR_IO_ERROR;
+    }
+  } else {
+    for (size_t i = 0; i < xfer_size; i++) {
+      rx[i] = (uint8_t)USART_SpiTransfer(ctx->config.peripheral_id, tx[i]);
+    }
   }
 
   sid_pal_gpio_write(client->client_selector, 1);
 
-  return SID_ERROR_NONE;
+  return err;
+}
+
+static void bus_serial_spi_xfer_complete(SPIDRV_Handle_t handle, Ecode_t transfer_status, int items_transferred)
+{
+  (void)handle;
+  (void)items_transferred;
+
+  sid_pal_serial_bus_efr32_spi_xfer_done_t done = bus.xfer_done;
+  void *arg = bus.xfer_arg;
+
+  sid_pal_gpio_write(bus.xfer_client->client_selector, 1);
+  bus.xfer_pending = false;
+
+  if (done != NULL) {
+    done((transfer_status == ECODE_EMDRV_SPIDRV_OK) ? SID_ERROR_NONE : SID_ERROR_IO_ERROR, arg);
+  }
 }
 
 static sid_error_t bus_serial_spi_destroy(const struct sid_pal_serial_bus_iface *iface)
@@ -117,8 +157,6 @@ sid_error_t sid_pal_serial_bus_efr32_spi_create(const struct sid_pal_serial_bus_
   if (!iface || !cfg) {
     return SID_ERROR_INVALID_ARGS;
   }
-  static struct serial_bus_efr32_spi_ctx bus = { 0 };
-
   sid_pal_gpio_pull_mode(SL_PIN_NSS, SID_PAL_GPIO_PULL_UP);
   sid_pal_gpio_set_direction(SL_PIN_NSS, SID_PAL_GPIO_DIRECTION_OUTPUT);
 
@@ -133,3 +171,42 @@ sid_error_t sid_pal_serial_bus_efr32_spi_create(const struct sid_pal_serial_bus_
   *iface = &bus.iface;
   return SID_ERROR_NONE;
 }
+
+sid_error_t sid_pal_serial_bus_efr32_spi_xfer_async(const struct sid_pal_serial_bus_iface *iface,
+                                                   const struct sid_pal_serial_bus_client *client,
+                                                   uint8_t *tx,
+                                                   uint8_t *rx,
+                                                   size_t xfer_size,
+                                                   sid_pal_serial_bus_efr32_spi_xfer_done_t done,
+                                                   void *arg)
+{
+  if (!iface || !client || !tx || !rx || !(xfer_size)) {
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+  struct serial_bus_efr32_spi_ctx *ctx = SLI_CONTAINEROF(iface, struct serial_bus_efr32_spi_ctx, iface);
+
+  if (ctx->config.spidrv_handle == NULL) {
+    return SID_ERROR_NOSUPPORT;
+  }
+
+  if (ctx->xfer_pending) {
+    return SID_ERROR_BUSY;
+  }
+
+  ctx->xfer_pending = true;
+  ctx->xfer_client = client;
+  ctx->xfer_done = done;
+  ctx->xfer_arg = arg;
+
+  sid_pal_gpio_write(client->client_selector, 0);
+
+  if (SPIDRV_MTransfer(*ctx->config.spidrv_handle, tx, rx, (int)xfer_size, bus_serial_spi_xfer_complete)
+      != ECODE_EMDRV_SPIDRV_OK) {
+    sid_pal_gpio_write(client->client_selector, 1);
+    ctx->xfer_pending = false;
+    return SID_ERROR_IO_ERROR;
+  }
+
+  return SID_ERROR_NONE;
+}
@@ -40,21 +40,296 @@
 // -----------------------------------------------------------------------------
 #include "psa/crypto.h"
 #include "sid_pal_crypto_ifc.h"
+#include "crypto_stream.h"
+#include "crypto_ecc_pool.h"
 #include "sl_malloc.h"
 #include "sl_psa_crypto.h"
+// Not available to the bare-metal projects, e.g. the PDP provisioner
+#if defined(__has_include)
+#if __has_include("sl_sidewalk_pal_config.h")
+#include "sl_sidewalk_pal_config.h"
+#endif
+#endif
+#include <em_core.h>
+#include <sid_pal_critical_region_ifc.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 
+// Without the PAL config keys are imported on every call and the ECC pool,
+// which needs the kernel, is left out
+#ifndef SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE 0
+#endif
+#ifndef SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE 32
+#endif
+#ifndef SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+#define SL_SIDEWALK_PAL_CRYPTO_ECC_POOL 0
+#endif
+
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+#define CRYPTO_KEY_CACHE_FNV_OFFSET  (2166136261UL)
+#define CRYPTO_KEY_CACHE_FNV_PRIME   (16777619UL)
+
+// Volatile PSA key kept imported for the key material of the stack. The
+// material is kept to tell hash collisions apart, users counts the operations
+// using the key right now, such an entry is never evicted.
+typedef struct {
+  psa_key_id_t key_id;
+  uint32_t hash;
+  uint32_t last_use;
+  uint16_t users;
+  uint8_t key_size;
+  psa_key_type_t type;
+  size_t bits;
+  psa_algorithm_t alg;
+  psa_key_usage_t usage;
+  uint8_t key[SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE];
+} crypto_key_cache_entry_t;
+#endif
+
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+#define ECC_POOL_PRK_SIZE             (32)
+#define ECC_POOL_PUK_MAX_SIZE         (64)
+#define ECC_POOL_TASK_STACK_SIZE      (SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_STACK_SIZE / sizeof(configSTACK_DEPTH_TYPE))
+
+typedef struct {
+  uint8_t prk[ECC_POOL_PRK_SIZE];
+  uint8_t puk[ECC_POOL_PUK_MAX_SIZE];
+} ecc_pool_key_t;
+
+// Key pairs of one curve, in the formats sid_pal_crypto_ecc_key_gen() exports
+typedef struct {
+  sid_pal_ecc_algo_t algo;
+  size_t puk_size;
+  uint8_t count;
+  ecc_pool_key_t keys[SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_SIZE];
+} ecc_pool_t;
+#endif
+
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
 static bool hal_init_done;
 static bool secure_vault_enabled = false;
 
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+static crypto_key_cache_entry_t key_cache[SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE];
+static uint32_t key_cache_clock;
+#endif
+
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+static ecc_pool_t ecc_pools[] = {
+  { .algo = SID_PAL_ECDH_SECP256R1, .puk_size = 64 },
+  { .algo = SID_PAL_ECDH_CURVE25519, .puk_size = 32 },
+};
+static TaskHandle_t ecc_pool_task_handle = NULL;
+static sli_sid_pal_crypto_ecc_pool_stats_t ecc_pool_stats;
+static SemaphoreHandle_t crypto_mutex = NULL;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+static uint32_t crypto_key_cache_hash(const psa_key_attributes_t *key_attr,
+                                      const uint8_t *key,
+                                      size_t key_size)
+{
+  const uint32_t attr_words[] = {
+    psa_get_key_type(key_attr),
+    psa_get_key_bits(key_attr),
+    psa_get_key_algorithm(key_attr),
+    psa_get_key_usage_flags(key_attr),
+  };
+  const uint8_t *attr_bytes = (const uint8_t *)attr_words;
+  uint32_t hash = CRYPTO_KEY_CACHE_FNV_OFFSET;
+
+  for (size_t i = 0; i < sizeof(attr_words); i++) {
+    hash = (hash ^ attr_bytes[i]) * CRYPTO_KEY_CACHE_FNV_PRIME;
+  }
+  for (size_t i = 0; i < key_size; i++) {
+    hash = (hash ^ key[i]) * CRYPTO_KEY_CACHE_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+static bool crypto_key_cache_match(const crypto_key_cache_entry_t *entry,
+                                   uint32_t hash,
+                                   const psa_key_attributes_t *key_attr,
+                                   const uint8_t *key,
+                                   size_t key_size)
+{
+  return entry->key_id != PSA_KEY_ID_NULL
+         && entry->hash == hash
+         && entry->type == psa_get_key_type(key_attr)
+         && entry->bits == psa_get_key_bits(key_attr)
+         && entry->alg == psa_get_key_algorithm(key_attr)
+         && entry->usage == psa_get_key_usage_flags(key_attr)
+         && entry->key_size == key_size
+         && memcmp(entry->key, key, key_size) == 0;
+}
+
+// Destroys the cached keys no operation is using at the moment
+static void crypto_key_cache_flush(void)
+{
+  for (size_t i = 0; i < SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE; i++) {
+    psa_key_id_t key_id = PSA_KEY_ID_NULL;
+
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_ATOMIC();
+    if (key_cache[i].key_id != PSA_KEY_ID_NULL && key_cache[i].users == 0) {
+      key_id = key_cache[i].key_id;
+      memset(&key_cache[i], 0, sizeof(key_cache[i]));
+    }
+    CORE_EXIT_ATOMIC();
+
+    if (key_id != PSA_KEY_ID_NULL) {
+      (void)psa_destroy_key(key_id);
+    }
+  }
+}
+#endif
+
+// Gives a PSA key holding the key material, it is imported only if the cache
+// does not have it yet. The key has to be handed back by crypto_key_release().
+static psa_status_t crypto_key_acquire(const psa_key_attributes_t *key_attr,
+                                       const uint8_t *key,
+                                       size_t key_size,
+                                       psa_key_id_t *key_id)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+  if (key_size > SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_MAX_KEY_SIZE) {
+    return psa_import_key(key_attr, key, key_size, key_id);
+  }
+
+  uint32_t hash = crypto_key_cache_hash(key_attr, key, key_size);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  for (size_t i = 0; i < SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE; i++) {
+    if (crypto_key_cache_match(&key_cache[i], hash, key_attr, key, key_size)) {
+      key_cache[i].users++;
+      key_cache[i].last_use = ++key_cache_clock;
+      *key_id = key_cache[i].key_id;
+      CORE_EXIT_ATOMIC();
+      return PSA_SUCCESS;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  psa_status_t ret = psa_import_key(key_attr, key, key_size, key_id);
+  if (ret == PSA_ERROR_INSUFFICIENT_MEMORY) {
+    // The cached keys may hold the key slots the import needs
+    crypto_key_cache_flush();
+    ret = psa_import_key(key_attr, key, key_size, key_id);
+  }
+  if (ret != PSA_SUCCESS) {
+    return ret;
+  }
+
+  // Take a free entry or evict the least recently used idle one. Without an
+  // idle entry the key is not cached and destroyed on release.
+  crypto_key_cache_entry_t *victim = NULL;
+  psa_key_id_t evicted_key_id = PSA_KEY_ID_NULL;
+
+  CORE_ENTER_ATOMIC();
+  for (size_t i = 0; i < SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE; i++) {
+    crypto_key_cache_entry_t *entry = &key_cache[i];
+    if (entry->users != 0) {
+      continue;
+    }
+    if (entry->key_id == PSA_KEY_ID_NULL) {
+      victim = entry;
+      break;
+    }
+    if (victim == NULL || (int32_t)(entry->last_use - victim->last_use) < 0) {
+      victim = entry;
+    }
+  }
+  if (victim != NULL) {
+    evicted_key_id = victim->key_id;
+    victim->key_id = *key_id;
+    victim->hash = hash;
+    victim->last_use = ++key_cache_clock;
+    victim->users = 1;
+    victim->key_size = (uint8_t)key_size;
+    victim->type = psa_get_key_type(key_attr);
+    victim->bits = psa_get_key_bits(key_attr);
+    victim->alg = psa_get_key_algorithm(key_attr);
+    victim->usage = psa_get_key_usage_flags(key_attr);
+    memcpy(victim->key, key, key_size);
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (evicted_key_id != PSA_KEY_ID_NULL) {
+    (void)psa_destroy_key(evicted_key_id);
+  }
+
+  return PSA_SUCCESS;
+#else
+  return psa_import_key(key_attr, key, key_size, key_id);
+#endif
+}
+
+// Hands back a key of crypto_key_acquire(), keys the cache does not keep are
+// destroyed
+static psa_status_t crypto_key_release(psa_key_id_t key_id)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+  bool cached = false;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  for (size_t i = 0; i < SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE; i++) {
+    if (key_cache[i].key_id == key_id && key_cache[i].users != 0) {
+      key_cache[i].users--;
+      cached = true;
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (cached) {
+    return PSA_SUCCESS;
+  }
+#endif
+
+  return psa_destroy_key(key_id);
+}
+
+// PSA is not built thread safe, the ECC pool task and the callers of the PAL
+// take turns through a recursive mutex. The init state is checked again once
+// the mutex is held, sid_pal_crypto_deinit() changes it under the mutex.
+static void crypto_lock(void)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  if (crypto_mutex != NULL) {
+    (void)xSemaphoreTakeRecursive(crypto_mutex, portMAX_DELAY);
+  }
+#endif
+}
+
+static void crypto_unlock(void)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  if (crypto_mutex != NULL) {
+    (void)xSemaphoreGiveRecursive(crypto_mutex);
+  }
+#endif
+}
+
 static sid_error_t efr32_crypto_init(void)
 {
   psa_status_t ret;
@@ -69,7 +344,14 @@ static sid_error_t efr32_crypto_init(void)
 
 static sid_error_t efr32_crypto_deinit(void)
 {
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+  crypto_key_cache_flush();
+#endif
   mbedtls_psa_crypto_free();
+#if SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE > 0
+  // Freeing the key store wiped any key still in use as well
+  memset(key_cache, 0, sizeof(key_cache));
+#endif
   return SID_ERROR_NONE;
 }
 
@@ -124,7 +406,7 @@ static sid_error_t efr32_crypto_hash(sid_pal_hash_params_t *params)
 static sid_error_t efr32_crypto_hmac(sid_pal_hmac_params_t *params)
 {
   psa_status_t ret;
-  psa_key_handle_t key_id;
+  psa_key_id_t key_id;
   psa_key_attributes_t key_attr;
   psa_algorithm_t hash_algo;
   psa_mac_operation_t mac_op;
@@ -152,7 +434,7 @@ static sid_error_t efr32_crypto_hmac(sid_pal_hmac_params_t *params)
   psa_set_key_usage_flags(&key_attr, PSA_KEY_USAGE_SIGN_HASH);
   psa_set_key_algorithm(&key_attr, PSA_ALG_HMAC(hash_algo));
 
-  ret = psa_import_key(&key_attr, params->key, params->key_size, &key_id);
+  ret = crypto_key_acquire(&key_attr, params->key, params->key_size, &key_id);
   if (ret != PSA_SUCCESS) {
     return SID_ERROR_GENERIC;
   }
@@ -160,13 +442,13 @@ static sid_error_t efr32_crypto_hmac(sid_pal_hmac_params_t *params)
   mac_op = psa_mac_operation_init();
   ret = psa_mac_sign_setup(&mac_op, key_id, PSA_ALG_HMAC(hash_algo));
   if (ret != PSA_SUCCESS) {
-    psa_destroy_key(key_id);
+    crypto_key_release(key_id);
     return SID_ERROR_GENERIC;
   }
 
   ret = psa_mac_update(&mac_op, params->data, params->data_size);
   if (ret != PSA_SUCCESS) {
-    psa_destroy_key(key_id);
+    crypto_key_release(key_id);
     return SID_ERROR_GENERIC;
   }
 
@@ -179,11 +461,11 @@ static sid_error_t efr32_crypto_hmac(sid_pal_hmac_params_t *params)
       || params->digest_size != PSA_MAC_LENGTH(PSA_KEY_TYPE_HMAC,
                                                params->key_size << 3,
                                                PSA_ALG_HMAC(hash_algo))) {
-    psa_destroy_key(key_id);
+    crypto_key_release(key_id);
     return SID_ERROR_GENERIC;
   }
 
-  ret = psa_destroy_key(key_id);
+  ret = crypto_key_release(key_id);
   if (ret != PSA_SUCCESS) {
     return SID_ERROR_GENERIC;
   }
@@ -194,7 +476,7 @@ static sid_error_t efr32_crypto_hmac(sid_pal_hmac_params_t *params)
 static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
 {
   psa_status_t ret;
-  psa_key_handle_t key_id;
+  psa_key_id_t key_id;
   psa_key_attributes_t key_attr;
   psa_algorithm_t aes_algo;
 
@@ -229,8 +511,8 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       psa_cipher_operation_t cipher_op;
       psa_set_key_usage_flags(&key_attr, PSA_KEY_USAGE_ENCRYPT);
 
-      ret = psa_import_key(&key_attr, params->key,
-                           params->key_size >> 3, &key_id);
+      ret = crypto_key_acquire(&key_attr, params->key,
+                               params->key_size >> 3, &key_id);
       if (ret != PSA_SUCCESS) {
         return SID_ERROR_GENERIC;
       }
@@ -238,13 +520,13 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       cipher_op = psa_cipher_operation_init();
       ret = psa_cipher_encrypt_setup(&cipher_op, key_id, aes_algo);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
       ret = psa_cipher_set_iv(&cipher_op, params->iv, params->iv_size);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
@@ -255,11 +537,11 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
                               params->in_size,
                               &(params->out_size));
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
       if (params->out_size != params->in_size) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
@@ -268,7 +550,7 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
                               params->out_size - params->out_size,
                               &(params->out_size));
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
       // The out_size will be 0 after running psa_cipher_finish()
@@ -279,8 +561,8 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       psa_cipher_operation_t cipher_op;
       psa_set_key_usage_flags(&key_attr, PSA_KEY_USAGE_DECRYPT);
 
-      ret = psa_import_key(&key_attr, params->key,
-                           params->key_size >> 3, &key_id);
+      ret = crypto_key_acquire(&key_attr, params->key,
+                               params->key_size >> 3, &key_id);
       if (ret != PSA_SUCCESS) {
         return SID_ERROR_GENERIC;
       }
@@ -288,13 +570,13 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       cipher_op = psa_cipher_operation_init();
       ret = psa_cipher_decrypt_setup(&cipher_op, key_id, aes_algo);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
       ret = psa_cipher_set_iv(&cipher_op, params->iv, params->iv_size);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
@@ -305,11 +587,11 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
                               params->in_size,
                               &(params->out_size));
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
       if (params->out_size != params->in_size) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
@@ -318,7 +600,7 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
                               params->out_size - params->out_size,
                               &(params->out_size));
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
       // The out_size will be 0 after running psa_cipher_finish()
@@ -329,8 +611,8 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       psa_mac_operation_t mac_op;
       psa_set_key_usage_flags(&key_attr, PSA_KEY_USAGE_SIGN_HASH);
 
-      ret = psa_import_key(&key_attr, params->key,
-                           params->key_size >> 3, &key_id);
+      ret = crypto_key_acquire(&key_attr, params->key,
+                               params->key_size >> 3, &key_id);
       if (ret != PSA_SUCCESS) {
         return SID_ERROR_GENERIC;
       }
@@ -338,13 +620,13 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       mac_op = psa_mac_operation_init();
       ret = psa_mac_sign_setup(&mac_op, key_id, aes_algo);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
       ret = psa_mac_update(&mac_op, params->in, params->in_size);
       if (ret != PSA_SUCCESS) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
 
@@ -357,7 +639,7 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
           || params->out_size != PSA_MAC_LENGTH(PSA_KEY_TYPE_AES,
                                                 params->key_size,
                                                 aes_algo)) {
-        psa_destroy_key(key_id);
+        crypto_key_release(key_id);
         return SID_ERROR_GENERIC;
       }
       break;
@@ -366,7 +648,7 @@ static sid_error_t efr32_crypto_aes_crypt(sid_pal_aes_params_t *params)
       return SID_ERROR_INVALID_ARGS;
   }
 
-  ret = psa_destroy_key(key_id);
+  ret = crypto_key_release(key_id);
   if (ret != PSA_SUCCESS) {
     return SID_ERROR_GENERIC;
   }
@@ -379,7 +661,7 @@ static sid_error_t efr32_crypto_aead_crypt(sid_pal_aead_params_t *params)
   uint8_t *cipher_mac = NULL;
   psa_status_t ret;
   sid_error_t sid_ret = SID_ERROR_NONE;
-  psa_key_handle_t key_id;
+  psa_key_id_t key_id;
   psa_key_attributes_t key_attr;
   psa_algorithm_t aead_algo;
 
@@ -418,8 +700,8 @@ static sid_error_t efr32_crypto_aead_crypt(sid_pal_aead_params_t *params)
         goto exit;
       }
 
-      ret = psa_import_key(&key_attr, params->key,
-                           params->key_size >> 3, &key_id);
+      ret = crypto_key_acquire(&key_attr, params->key,
+                               params->key_size >> 3, &key_id);
       if (ret != PSA_SUCCESS) {
         sid_ret = SID_ERROR_GENERIC;
         goto exit;
@@ -463,8 +745,8 @@ static sid_error_t efr32_crypto_aead_crypt(sid_pal_aead_params_t *params)
       memcpy(cipher_mac, params->in, params->in_size);
       memcpy(cipher_mac + params->in_size, params->mac, params->mac_size);
 
-      ret = psa_import_key(&key_attr, params->key,
-                           params->key_size >> 3, &key_id);
+      ret = crypto_key_acquire(&key_attr, params->key,
+                               params->key_size >> 3, &key_id);
       if (ret != PSA_SUCCESS) {
         sid_ret = SID_ERROR_GENERIC;
         goto exit;
@@ -493,7 +775,7 @@ static sid_error_t efr32_crypto_aead_crypt(sid_pal_aead_params_t *params)
   }
 
   clnup:
-  ret = psa_destroy_key(key_id);
+  ret = crypto_key_release(key_id);
   if (ret != PSA_SUCCESS && sid_ret == SID_ERROR_NONE) {
     sid_ret = SID_ERROR_GENERIC;
   }
@@ -506,6 +788,51 @@ static sid_error_t efr32_crypto_aead_crypt(sid_pal_aead_params_t *params)
   return sid_ret;
 }
 
+// Returns the stream to idle, its PSA operation has to be completed already
+static void crypto_stream_reset(sli_sid_pal_crypto_stream_t *stream)
+{
+  if (stream->key_id != PSA_KEY_ID_NULL) {
+    (void)crypto_key_release(stream->key_id);
+  }
+  memset(stream, 0, sizeof(*stream));
+}
+
+static void crypto_stream_abort(sli_sid_pal_crypto_stream_t *stream)
+{
+  switch (stream->kind) {
+    case SLI_SID_PAL_CRYPTO_STREAM_CIPHER:
+      (void)psa_cipher_abort(&stream->op.cipher);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_MAC:
+      (void)psa_mac_abort(&stream->op.mac);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_AEAD:
+      (void)psa_aead_abort(&stream->op.aead);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_HASH:
+      (void)psa_hash_abort(&stream->op.hash);
+      break;
+
+    default:
+      break;
+  }
+  crypto_stream_reset(stream);
+}
+
+static size_t crypto_chunks_size(const sli_sid_pal_crypto_chunk_t *chunks, size_t count)
+{
+  size_t size = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    size += chunks[i].size;
+  }
+
+  return size;
+}
+
 static sid_error_t efr32_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
 {
   psa_status_t ret;
@@ -836,6 +1163,128 @@ static sid_error_t efr32_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params
 
   return sid_ret;
 }
+
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+static ecc_pool_t *ecc_pool_find(sid_pal_ecc_algo_t algo)
+{
+  for (size_t i = 0; i < sizeof(ecc_pools) / sizeof(ecc_pools[0]); i++) {
+    if (ecc_pools[i].algo == algo) {
+      return &ecc_pools[i];
+    }
+  }
+
+  return NULL;
+}
+
+static void ecc_pool_task(void *context)
+{
+  (void)context;
+
+  while (1) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    for (size_t i = 0; i < sizeof(ecc_pools) / sizeof(ecc_pools[0]); i++) {
+      ecc_pool_t *pool = &ecc_pools[i];
+
+      while (1) {
+        ecc_pool_key_t key;
+        sid_pal_ecc_key_gen_params_t params = {
+          .algo = pool->algo,
+          .prk = key.prk,
+          .prk_size = ECC_POOL_PRK_SIZE,
+          .puk = key.puk,
+          .puk_size = pool->puk_size,
+        };
+        sid_error_t ret = SID_ERROR_UNINITIALIZED;
+
+        // Held across the key generation and the store, so the PAL cannot be
+        // deinitialized in between
+        crypto_lock();
+        if (hal_init_done && (pool->count < SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_SIZE)) {
+          ret = efr32_crypto_ecc_key_gen(&params);
+          if ((ret == SID_ERROR_NONE) && hal_init_done) {
+            sid_pal_enter_critical_region();
+            pool->keys[pool->count++] = key;
+            ecc_pool_stats.refills++;
+            sid_pal_exit_critical_region();
+          }
+        }
+        crypto_unlock();
+        memset(&key, 0, sizeof(key));
+
+        if (ret != SID_ERROR_NONE) {
+          // Full, deinitialized or failed, retried when the next key pair is
+          // taken
+          break;
+        }
+      }
+    }
+  }
+}
+
+static void ecc_pool_start(void)
+{
+  if (ecc_pool_task_handle == NULL) {
+    BaseType_t status = xTaskCreate(ecc_pool_task,
+                                    "sid_ecc_pool",
+                                    ECC_POOL_TASK_STACK_SIZE,
+                                    NULL,
+                                    SL_SIDEWALK_PAL_CRYPTO_ECC_POOL_TASK_PRIORITY,
+                                    &ecc_pool_task_handle);
+    if (status != pdPASS) {
+      // Key pairs are generated inline
+      ecc_pool_task_handle = NULL;
+      return;
+    }
+  }
+
+  (void)xTaskNotifyGive(ecc_pool_task_handle);
+}
+
+static void ecc_pool_clear(void)
+{
+  sid_pal_enter_critical_region();
+  for (size_t i = 0; i < sizeof(ecc_pools) / sizeof(ecc_pools[0]); i++) {
+    ecc_pools[i].count = 0;
+    memset(ecc_pools[i].keys, 0, sizeof(ecc_pools[i].keys));
+  }
+  sid_pal_exit_critical_region();
+}
+
+// Hands out a pre-generated key pair if the request matches a pool, false
+// means the key pair has to be generated inline
+static bool ecc_pool_take(sid_pal_ecc_key_gen_params_t *params)
+{
+  ecc_pool_t *pool = ecc_pool_find(params->algo);
+  bool taken = false;
+
+  if (pool == NULL
+      || params->prk_size != ECC_POOL_PRK_SIZE
+      || params->puk_size != pool->puk_size) {
+    return false;
+  }
+
+  sid_pal_enter_critical_region();
+  if (pool->count > 0) {
+    ecc_pool_key_t *key = &pool->keys[--pool->count];
+    memcpy(params->prk, key->prk, ECC_POOL_PRK_SIZE);
+    memcpy(params->puk, key->puk, pool->puk_size);
+    memset(key, 0, sizeof(*key));
+    ecc_pool_stats.hits++;
+    taken = true;
+  } else {
+    ecc_pool_stats.misses++;
+  }
+  sid_pal_exit_critical_region();
+
+  if (ecc_pool_task_handle != NULL) {
+    (void)xTaskNotifyGive(ecc_pool_task_handle);
+  }
+
+  return taken;
+}
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -848,12 +1297,24 @@ void silabs_crypto_enable_sv(void)
 
 sid_error_t sid_pal_crypto_init()
 {
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  if (crypto_mutex == NULL) {
+    crypto_mutex = xSemaphoreCreateRecursiveMutex();
+    if (crypto_mutex == NULL) {
+      return SID_ERROR_OOM;
+    }
+  }
+#endif
+
+  crypto_lock();
   if (hal_init_done) {
+    crypto_unlock();
     return SID_ERROR_NONE;
   }
 
   sid_error_t ret = efr32_crypto_init();
   if (ret != SID_ERROR_NONE) {
+    crypto_unlock();
     return ret;
   }
 
@@ -863,21 +1324,31 @@ sid_error_t sid_pal_crypto_init()
   ret = sid_pal_crypto_rand((uint8_t*)&seed, sizeof(seed));
   if (ret == SID_ERROR_NONE) {
     srand(seed);
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+    ecc_pool_start();
+#endif
   } else {
     hal_init_done = false;
   }
+  crypto_unlock();
 
   return ret;
 }
 
 sid_error_t sid_pal_crypto_deinit(void)
 {
+  crypto_lock();
   if (!hal_init_done) {
+    crypto_unlock();
     return SID_ERROR_NONE;
   }
 
-  efr32_crypto_deinit();
   hal_init_done = false;
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  ecc_pool_clear();
+#endif
+  efr32_crypto_deinit();
+  crypto_unlock();
 
   return SID_ERROR_NONE;
 }
@@ -892,7 +1363,11 @@ sid_error_t sid_pal_crypto_rand(uint8_t *rand, size_t size)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_rand(rand, size);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_rand(rand, size) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_hash(sid_pal_hash_params_t *params)
@@ -905,7 +1380,11 @@ sid_error_t sid_pal_crypto_hash(sid_pal_hash_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_hash(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_hash(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
@@ -918,7 +1397,11 @@ sid_error_t sid_pal_crypto_hmac(sid_pal_hmac_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_hmac(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_hmac(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
@@ -931,7 +1414,11 @@ sid_error_t sid_pal_crypto_aes_crypt(sid_pal_aes_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_aes_crypt(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_aes_crypt(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
@@ -944,7 +1431,11 @@ sid_error_t sid_pal_crypto_aead_crypt(sid_pal_aead_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_aead_crypt(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_aead_crypt(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
@@ -957,7 +1448,11 @@ sid_error_t sid_pal_crypto_ecc_dsa(sid_pal_dsa_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_ecc_dsa(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_ecc_dsa(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
@@ -970,7 +1465,11 @@ sid_error_t sid_pal_crypto_ecc_ecdh(sid_pal_ecdh_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_ecc_ecdh(params);
+  crypto_lock();
+  sid_error_t ret = hal_init_done ? efr32_crypto_ecc_ecdh(params) : SID_ERROR_UNINITIALIZED;
+  crypto_unlock();
+
+  return ret;
 }
 
 sid_error_t sid_pal_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
@@ -983,5 +1482,629 @@ sid_error_t sid_pal_crypto_ecc_key_gen(sid_pal_ecc_key_gen_params_t *params)
     return SID_ERROR_NULL_POINTER;
   }
 
-  return efr32_crypto_ecc_key_gen(params);
+  sid_error_t ret = SID_ERROR_UNINITIALIZED;
+  bool taken = false;
+
+  crypto_lock();
+  if (hal_init_done) {
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+    taken = ecc_pool_take(params);
+#endif
+    ret = taken ? SID_ERROR_NONE : efr32_crypto_ecc_key_gen(params);
+  }
+  crypto_unlock();
+
+  return ret;
+}
+
+void sli_sid_pal_crypto_get_ecc_pool_stats(sli_sid_pal_crypto_ecc_pool_stats_t *stats)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  sid_pal_enter_critical_region();
+  *stats = ecc_pool_stats;
+  stats->p256_available = ecc_pool_find(SID_PAL_ECDH_SECP256R1)->count;
+  stats->x25519_available = ecc_pool_find(SID_PAL_ECDH_CURVE25519)->count;
+  sid_pal_exit_critical_region();
+#else
+  memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void sli_sid_pal_crypto_reset_ecc_pool_stats(void)
+{
+#if SL_SIDEWALK_PAL_CRYPTO_ECC_POOL
+  sid_pal_enter_critical_region();
+  ecc_pool_stats.hits = 0;
+  ecc_pool_stats.misses = 0;
+  ecc_pool_stats.refills = 0;
+  sid_pal_exit_critical_region();
+#endif
+}
+
+static sid_error_t crypto_aes_start(sli_sid_pal_crypto_stream_t *stream,
+                                    const sid_pal_aes_params_t *params)
+{
+  psa_status_t ret;
+  psa_key_attributes_t key_attr;
+  psa_algorithm_t aes_algo;
+  psa_key_usage_t key_usage;
+  sli_sid_pal_crypto_stream_kind_t kind;
+
+  if (!hal_init_done) {
+    return SID_ERROR_UNINITIALIZED;
+  }
+
+  if (!stream || !params || !params->key) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (stream->kind != SLI_SID_PAL_CRYPTO_STREAM_IDLE) {
+    return SID_ERROR_BUSY;
+  }
+
+  switch (params->algo) {
+    case SID_PAL_AES_CMAC_128:
+      if (params->mode != SID_PAL_CRYPTO_MAC_CALCULATE) {
+        return SID_ERROR_INVALID_ARGS;
+      }
+      aes_algo = PSA_ALG_CMAC;
+      key_usage = PSA_KEY_USAGE_SIGN_HASH;
+      kind = SLI_SID_PAL_CRYPTO_STREAM_MAC;
+      break;
+
+    case SID_PAL_AES_CTR_128:
+      if (params->mode == SID_PAL_CRYPTO_ENCRYPT) {
+        key_usage = PSA_KEY_USAGE_ENCRYPT;
+      } else if (params->mode == SID_PAL_CRYPTO_DECRYPT) {
+        key_usage = PSA_KEY_USAGE_DECRYPT;
+      } else {
+        return SID_ERROR_INVALID_ARGS;
+      }
+      aes_algo = PSA_ALG_CTR;
+      kind = SLI_SID_PAL_CRYPTO_STREAM_CIPHER;
+      break;
+
+    default:
+      return SID_ERROR_NOSUPPORT;
+  }
+
+  key_attr = psa_key_attributes_init();
+  psa_set_key_type(&key_attr, PSA_KEY_TYPE_AES);
+  psa_set_key_bits(&key_attr, params->key_size);
+  psa_set_key_algorithm(&key_attr, aes_algo);
+  psa_set_key_usage_flags(&key_attr, key_usage);
+
+  memset(stream, 0, sizeof(*stream));
+  ret = crypto_key_acquire(&key_attr, params->key,
+                           params->key_size >> 3, &stream->key_id);
+  if (ret != PSA_SUCCESS) {
+    stream->key_id = PSA_KEY_ID_NULL;
+    return SID_ERROR_GENERIC;
+  }
+
+  stream->kind = kind;
+  stream->mode = params->mode;
+  if (kind == SLI_SID_PAL_CRYPTO_STREAM_MAC) {
+    stream->tag_size = PSA_MAC_LENGTH(PSA_KEY_TYPE_AES, params->key_size, aes_algo);
+    stream->op.mac = psa_mac_operation_init();
+    ret = psa_mac_sign_setup(&stream->op.mac, stream->key_id, aes_algo);
+  } else {
+    stream->op.cipher = psa_cipher_operation_init();
+    if (params->mode == SID_PAL_CRYPTO_ENCRYPT) {
+      ret = psa_cipher_encrypt_setup(&stream->op.cipher, stream->key_id, aes_algo);
+    } else {
+      ret = psa_cipher_decrypt_setup(&stream->op.cipher, stream->key_id, aes_algo);
+    }
+    if (ret == PSA_SUCCESS) {
+      ret = psa_cipher_set_iv(&stream->op.cipher, params->iv, params->iv_size);
+    }
+  }
+
+  if (ret != PSA_SUCCESS) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_GENERIC;
+  }
+
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_aes_start(sli_sid_pal_crypto_stream_t *stream,
+                                         const sid_pal_aes_params_t *params)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_aes_start(stream, params);
+  crypto_unlock();
+
+  return ret;
+}
+
+static sid_error_t crypto_aead_start(sli_sid_pal_crypto_stream_t *stream,
+                                     const sid_pal_aead_params_t *params)
+{
+  psa_status_t ret;
+  psa_key_attributes_t key_attr;
+  psa_algorithm_t aead_algo;
+
+  if (!hal_init_done) {
+    return SID_ERROR_UNINITIALIZED;
+  }
+
+  if (!stream || !params || !params->key) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (stream->kind != SLI_SID_PAL_CRYPTO_STREAM_IDLE) {
+    return SID_ERROR_BUSY;
+  }
+
+  switch (params->algo) {
+    case SID_PAL_AEAD_GCM_128:
+      aead_algo = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_GCM, params->mac_size);
+      break;
+
+    case SID_PAL_AEAD_CCM_128:
+    case SID_PAL_AEAD_CCM_STAR_128:
+      aead_algo = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, params->mac_size);
+      break;
+
+    default:
+      return SID_ERROR_NOSUPPORT;
+  }
+
+  if (params->mode != SID_PAL_CRYPTO_ENCRYPT && params->mode != SID_PAL_CRYPTO_DECRYPT) {
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+  key_attr = psa_key_attributes_init();
+  psa_set_key_type(&key_attr, PSA_KEY_TYPE_AES);
+  psa_set_key_bits(&key_attr, params->key_size);
+  psa_set_key_algorithm(&key_attr, aead_algo);
+  psa_set_key_usage_flags(&key_attr,
+                          (params->mode == SID_PAL_CRYPTO_ENCRYPT)
+                          ? PSA_KEY_USAGE_ENCRYPT : PSA_KEY_USAGE_DECRYPT);
+
+  memset(stream, 0, sizeof(*stream));
+  ret = crypto_key_acquire(&key_attr, params->key,
+                           params->key_size >> 3, &stream->key_id);
+  if (ret != PSA_SUCCESS) {
+    stream->key_id = PSA_KEY_ID_NULL;
+    return SID_ERROR_GENERIC;
+  }
+
+  stream->kind = SLI_SID_PAL_CRYPTO_STREAM_AEAD;
+  stream->mode = params->mode;
+  stream->tag_size = params->mac_size;
+  stream->op.aead = psa_aead_operation_init();
+  if (params->mode == SID_PAL_CRYPTO_ENCRYPT) {
+    ret = psa_aead_encrypt_setup(&stream->op.aead, stream->key_id, aead_algo);
+  } else {
+    ret = psa_aead_decrypt_setup(&stream->op.aead, stream->key_id, aead_algo);
+  }
+  if (ret == PSA_SUCCESS) {
+    // CCM needs the lengths before the nonce, for GCM they are only checked
+    ret = psa_aead_set_lengths(&stream->op.aead, params->aad_size, params->in_size);
+  }
+  if (ret == PSA_SUCCESS) {
+    ret = psa_aead_set_nonce(&stream->op.aead, params->iv, params->iv_size);
+  }
+
+  if (ret != PSA_SUCCESS) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_GENERIC;
+  }
+
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_aead_start(sli_sid_pal_crypto_stream_t *stream,
+                                          const sid_pal_aead_params_t *params)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_aead_start(stream, params);
+  crypto_unlock();
+
+  return ret;
+}
+
+static sid_error_t crypto_hash_start(sli_sid_pal_crypto_stream_t *stream,
+                                     sid_pal_hash_algo_t algo)
+{
+  psa_status_t ret;
+  psa_algorithm_t hash_algo;
+
+  if (!hal_init_done) {
+    return SID_ERROR_UNINITIALIZED;
+  }
+
+  if (!stream) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (stream->kind != SLI_SID_PAL_CRYPTO_STREAM_IDLE) {
+    return SID_ERROR_BUSY;
+  }
+
+  switch (algo) {
+    case SID_PAL_HASH_SHA256:
+      hash_algo = PSA_ALG_SHA_256;
+      break;
+
+    case SID_PAL_HASH_SHA512:
+      hash_algo = PSA_ALG_SHA_512;
+      break;
+
+    default:
+      return SID_ERROR_NOSUPPORT;
+  }
+
+  memset(stream, 0, sizeof(*stream));
+  stream->kind = SLI_SID_PAL_CRYPTO_STREAM_HASH;
+  stream->tag_size = PSA_HASH_LENGTH(hash_algo);
+  stream->op.hash = psa_hash_operation_init();
+  ret = psa_hash_setup(&stream->op.hash, hash_algo);
+  if (ret != PSA_SUCCESS) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_GENERIC;
+  }
+
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_hash_start(sli_sid_pal_crypto_stream_t *stream,
+                                          sid_pal_hash_algo_t algo)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_hash_start(stream, algo);
+  crypto_unlock();
+
+  return ret;
+}
+
+static sid_error_t crypto_stream_update_ad(sli_sid_pal_crypto_stream_t *stream,
+                                           uint8_t const *aad,
+                                           size_t aad_size)
+{
+  if (!stream) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (!aad && aad_size) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (stream->kind != SLI_SID_PAL_CRYPTO_STREAM_AEAD) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_INVALID_ARGS;
+  }
+
+  if (psa_aead_update_ad(&stream->op.aead, aad, aad_size) != PSA_SUCCESS) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_GENERIC;
+  }
+
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_stream_update_ad(sli_sid_pal_crypto_stream_t *stream,
+                                                uint8_t const *aad,
+                                                size_t aad_size)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_stream_update_ad(stream, aad, aad_size);
+  crypto_unlock();
+
+  return ret;
+}
+
+static sid_error_t crypto_stream_update(sli_sid_pal_crypto_stream_t *stream,
+                                        uint8_t const *in,
+                                        size_t in_size,
+                                        uint8_t *out,
+                                        size_t out_size,
+                                        size_t *out_len)
+{
+  psa_status_t ret;
+  sid_error_t sid_ret = SID_ERROR_GENERIC;
+
+  if (!stream) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  // Argument errors end the stream as PSA failures do, so its key is released
+  if (!in && in_size) {
+    crypto_stream_abort(stream);
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  switch (stream->kind) {
+    case SLI_SID_PAL_CRYPTO_STREAM_CIPHER:
+      if (!out || !out_len) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+        break;
+      }
+      ret = psa_cipher_update(&stream->op.cipher, in, in_size, out, out_size, out_len);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_AEAD:
+      if (!out || !out_len) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+        break;
+      }
+      ret = psa_aead_update(&stream->op.aead, in, in_size, out, out_size, out_len);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_MAC:
+      ret = psa_mac_update(&stream->op.mac, in, in_size);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_HASH:
+      ret = psa_hash_update(&stream->op.hash, in, in_size);
+      break;
+
+    default:
+      return SID_ERROR_INVALID_ARGS;
+  }
+
+  if (ret != PSA_SUCCESS) {
+    crypto_stream_abort(stream);
+    return sid_ret;
+  }
+
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_stream_update(sli_sid_pal_crypto_stream_t *stream,
+                                             uint8_t const *in,
+                                             size_t in_size,
+                                             uint8_t *out,
+                                             size_t out_size,
+                                             size_t *out_len)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_stream_update(stream, in, in_size, out, out_size, out_len);
+  crypto_unlock();
+
+  return ret;
+}
+
+static sid_error_t crypto_stream_finish(sli_sid_pal_crypto_stream_t *stream,
+                                        uint8_t *out,
+                                        size_t out_size,
+                                        size_t *out_len,
+                                        uint8_t *tag,
+                                        size_t tag_size)
+{
+  psa_status_t ret;
+  sid_error_t sid_ret = SID_ERROR_GENERIC;
+  size_t len = 0;
+  size_t produced_tag_size = 0;
+
+  if (!stream) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  if (!out_len) {
+    out_len = &len;
+  }
+  *out_len = 0;
+
+  switch (stream->kind) {
+    case SLI_SID_PAL_CRYPTO_STREAM_CIPHER:
+      if (!out) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+        break;
+      }
+      ret = psa_cipher_finish(&stream->op.cipher, out, out_size, out_len);
+      produced_tag_size = stream->tag_size;
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_MAC:
+      if (!tag) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+        break;
+      }
+      ret = psa_mac_sign_finish(&stream->op.mac, tag, tag_size, &produced_tag_size);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_HASH:
+      if (!tag) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+        break;
+      }
+      ret = psa_hash_finish(&stream->op.hash, tag, tag_size, &produced_tag_size);
+      break;
+
+    case SLI_SID_PAL_CRYPTO_STREAM_AEAD:
+      if (!out || !tag) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+        sid_ret = SID_ERROR_NULL_POINTER;
+      } else if (stream->mode == SID_PAL_CRYPTO_ENCRYPT) {
+        ret = psa_aead_finish(&stream->op.aead, out, out_size, out_len,
+                              tag, tag_size, &produced_tag_size);
+      } else if (tag_size < stream->tag_size) {
+        ret = PSA_ERROR_INVALID_ARGUMENT;
+      } else {
+        ret = psa_aead_verify(&stream->op.aead, out, out_size, out_len,
+                              tag, stream->tag_size);
+        produced_tag_size = stream->tag_size;
+      }
+      break;
+
+    default:
+      return SID_ERROR_INVALID_ARGS;
+  }
+
+  if (ret != PSA_SUCCESS || produced_tag_size != stream->tag_size) {
+    crypto_stream_abort(stream);
+    return sid_ret;
+  }
+
+  crypto_stream_reset(stream);
+  return SID_ERROR_NONE;
+}
+
+sid_error_t sli_sid_pal_crypto_stream_finish(sli_sid_pal_crypto_stream_t *stream,
+                                             uint8_t *out,
+                                             size_t out_size,
+                                             size_t *out_len,
+                                             uint8_t *tag,
+                                             size_t tag_size)
+{
+  crypto_lock();
+  sid_error_t ret = crypto_stream_finish(stream, out, out_size, out_len, tag, tag_size);
+  crypto_unlock();
+
+  return ret;
+}
+
+void sli_sid_pal_crypto_stream_abort(sli_sid_pal_crypto_stream_t *stream)
+{
+  if (stream) {
+    crypto_lock();
+    crypto_stream_abort(stream);
+    crypto_unlock();
+  }
+}
+
+sid_error_t sli_sid_pal_crypto_aes_crypt_sg(sid_pal_aes_params_t *params,
+                                            const sli_sid_pal_crypto_chunk_t *in,
+                                            size_t in_count)
+{
+  sli_sid_pal_crypto_stream_t stream = { 0 };
+  sid_error_t sid_ret;
+  size_t in_size;
+  size_t written = 0;
+  size_t out_len;
+
+  if (!params || !params->out || (!in && in_count)) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  in_size = crypto_chunks_size(in, in_count);
+  if (in_size == 0) {
+    return SID_ERROR_PARAM_OUT_OF_RANGE;
+  }
+
+  if (params->algo == SID_PAL_AES_CTR_128 && in_size > params->out_size) {
+    return SID_ERROR_PARAM_OUT_OF_RANGE;
+  }
+
+  sid_ret = sli_sid_pal_crypto_aes_start(&stream, params);
+  if (sid_ret != SID_ERROR_NONE) {
+    return sid_ret;
+  }
+
+  bool is_mac = (stream.kind == SLI_SID_PAL_CRYPTO_STREAM_MAC);
+  size_t mac_size = stream.tag_size;
+
+  for (size_t i = 0; i < in_count; i++) {
+    if (is_mac) {
+      sid_ret = sli_sid_pal_crypto_stream_update(&stream, in[i].data, in[i].size,
+                                                 NULL, 0, NULL);
+    } else {
+      sid_ret = sli_sid_pal_crypto_stream_update(&stream, in[i].data, in[i].size,
+                                                 params->out + written,
+                                                 params->out_size - written,
+                                                 &out_len);
+      written += out_len;
+    }
+    if (sid_ret != SID_ERROR_NONE) {
+      return sid_ret;
+    }
+  }
+
+  if (is_mac) {
+    sid_ret = sli_sid_pal_crypto_stream_finish(&stream, NULL, 0, NULL,
+                                               params->out, params->out_size);
+    written = mac_size;
+  } else {
+    sid_ret = sli_sid_pal_crypto_stream_finish(&stream,
+                                               params->out + written,
+                                               params->out_size - written,
+                                               &out_len, NULL, 0);
+    written += out_len;
+    if (sid_ret == SID_ERROR_NONE && written != in_size) {
+      sid_ret = SID_ERROR_GENERIC;
+    }
+  }
+
+  if (sid_ret == SID_ERROR_NONE) {
+    params->out_size = written;
+  }
+
+  return sid_ret;
+}
+
+sid_error_t sli_sid_pal_crypto_aead_crypt_sg(sid_pal_aead_params_t *params,
+                                             const sli_sid_pal_crypto_chunk_t *aad,
+                                             size_t aad_count,
+                                             const sli_sid_pal_crypto_chunk_t *in,
+                                             size_t in_count)
+{
+  sli_sid_pal_crypto_stream_t stream = { 0 };
+  sid_pal_aead_params_t setup;
+  sid_error_t sid_ret;
+  size_t written = 0;
+  size_t out_len;
+
+  if (!params || !params->out || (!aad && aad_count) || (!in && in_count)) {
+    return SID_ERROR_NULL_POINTER;
+  }
+
+  setup = *params;
+  setup.aad_size = crypto_chunks_size(aad, aad_count);
+  setup.in_size = crypto_chunks_size(in, in_count);
+  if (setup.aad_size == 0 || setup.in_size == 0 || params->mac == NULL) {
+    return SID_ERROR_PARAM_OUT_OF_RANGE;
+  }
+
+  if (setup.in_size > params->out_size) {
+    return SID_ERROR_PARAM_OUT_OF_RANGE;
+  }
+
+  sid_ret = sli_sid_pal_crypto_aead_start(&stream, &setup);
+  if (sid_ret != SID_ERROR_NONE) {
+    return sid_ret;
+  }
+
+  for (size_t i = 0; i < aad_count; i++) {
+    sid_ret = sli_sid_pal_crypto_stream_update_ad(&stream, aad[i].data, aad[i].size);
+    if (sid_ret != SID_ERROR_NONE) {
+      return sid_ret;
+    }
+  }
+
+  for (size_t i = 0; i < in_count; i++) {
+    sid_ret = sli_sid_pal_crypto_stream_update(&stream, in[i].data, in[i].size,
+                                               params->out + written,
+                                               params->out_size - written,
+                                               &out_len);
+    if (sid_ret != SID_ERROR_NONE) {
+      return sid_ret;
+    }
+    written += out_len;
+  }
+
+  sid_ret = sli_sid_pal_crypto_stream_finish(&stream,
+                                             params->out + written,
+                                             params->out_size - written,
+                                             &out_len,
+                                             params->mac,
+                                             params->mac_size);
+  written += out_len;
+  if (sid_ret == SID_ERROR_NONE && written != setup.in_size) {
+    sid_ret = SID_ERROR_GENERIC;
+  }
+
+  if (sid_ret == SID_ERROR_NONE) {
+    params->out_size = written;
+  }
+
+  return sid_ret;
 }
@@ -40,7 +40,7 @@
 // -----------------------------------------------------------------------------
 
 #include <sid_pal_storage_kv_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include <sid_pal_assert_ifc.h>
 #include <stdalign.h>
 #include <stdbool.h>
@@ -48,11 +48,21 @@
 #include <string.h>
 #include "nvm3_manager.h"
 #include "sl_malloc.h"
+#include "sl_sidewalk_pal_config.h"
+#include "storage_kv.h"
+#if SL_SIDEWALK_PAL_KV_CACHE
+#include <sid_pal_storage_kv_internal_group_ids.h>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
+#endif
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_STORAGE
+
 struct storage_kv_record_header {
   uint32_t data_size;
   uint16_t key;
@@ -60,15 +70,91 @@ struct storage_kv_record_header {
 
 #define STORAGE_KV_REC_HDR_SIZE (sizeof(struct storage_kv_record_header))
 
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+// RAM copy of the record layout of a group object
+struct storage_kv_dir_record {
+  uint16_t key;
+  uint16_t offset;
+  uint32_t data_size;
+};
+
+struct storage_kv_dir_group {
+  bool valid;
+  // More records in the group than a directory can hold, lookups scan flash
+  bool oversized;
+  uint16_t group;
+  uint8_t record_cnt;
+  uint32_t last_used;
+  struct storage_kv_dir_record records[SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM];
+};
+#endif
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+// Journal entry, followed by data_size bytes of record data. Entries are only
+// appended, a later entry of the same group and key supersedes earlier ones.
+struct storage_kv_journal_entry {
+  uint16_t group;
+  uint16_t key;
+  uint32_t data_size;
+};
+
+#define STORAGE_KV_JOURNAL_ENTRY_SIZE (sizeof(struct storage_kv_journal_entry))
+#define STORAGE_KV_CACHE_GROUP_NUM    (sizeof(kv_cache_group_ids) / sizeof(kv_cache_group_ids[0]))
+
+// Write-back cached group, the RAM image is ahead of flash for the dirty keys
+struct storage_kv_cache_group {
+  uint16_t group;
+  bool loaded;
+  uint8_t dirty_cnt;
+  uint16_t dirty_keys[SL_SIDEWALK_PAL_KV_CACHE_DIRTY_RECORD_NUM];
+  uint8_t *image;
+  size_t image_len;
+};
+#endif
+
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+static struct storage_kv_dir_group kv_dir[SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM];
+static uint32_t kv_dir_use_cnt = 0;
+#endif
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+static const uint16_t kv_cache_group_ids[] = SL_SIDEWALK_PAL_KV_CACHE_GROUPS;
+static struct storage_kv_cache_group kv_cache[STORAGE_KV_CACHE_GROUP_NUM];
+// RAM copy of the journal object
+static uint8_t kv_journal[SL_SIDEWALK_PAL_KV_JOURNAL_SIZE];
+static size_t kv_journal_len = 0;
+static SemaphoreHandle_t kv_cache_lock = NULL;
+static TimerHandle_t kv_cache_flush_timer = NULL;
+#endif
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
-static sid_error_t storage_kv_is_record_exist_in_group(uint16_t group, uint16_t key, size_t *record_offset);
+static Ecode_t storage_kv_find_record(uint16_t group, uint16_t key, size_t *record_offset, uint32_t *data_size);
+static Ecode_t storage_kv_scan_record(uint16_t group, uint16_t key, size_t *record_offset, uint32_t *data_size);
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+static const struct storage_kv_dir_group *storage_kv_dir_get(uint16_t group);
+#endif
+static void storage_kv_dir_invalidate(uint16_t group);
+static void storage_kv_dir_update(uint16_t group, const uint8_t *object, size_t object_length);
+static size_t storage_kv_image_put(uint8_t *image, size_t image_len, const size_t *record_offset, uint32_t old_data_size, uint16_t key, const void *p_data, uint32_t len);
+#if SL_SIDEWALK_PAL_KV_CACHE
+static Ecode_t storage_kv_image_find(const uint8_t *image, size_t image_len, uint16_t key, size_t *record_offset, uint32_t *data_size);
+static struct storage_kv_cache_group *storage_kv_cache_find(uint16_t group);
+static Ecode_t storage_kv_cache_load(struct storage_kv_cache_group *cache);
+static Ecode_t storage_kv_cache_record_get(struct storage_kv_cache_group *cache, uint16_t key, void *p_data, uint32_t len, uint32_t *p_len);
+static Ecode_t storage_kv_cache_record_set(struct storage_kv_cache_group *cache, uint16_t key, const void *p_data, uint32_t len);
+static Ecode_t storage_kv_cache_release(struct storage_kv_cache_group *cache);
+static Ecode_t storage_kv_cache_flush(void);
+static void storage_kv_cache_flush_timer_cb(TimerHandle_t timer);
+static Ecode_t storage_kv_journal_replay(const uint8_t *journal, size_t journal_len);
+static Ecode_t storage_kv_journal_load(void);
+#endif
 
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
@@ -85,6 +171,39 @@ sid_error_t sid_pal_storage_kv_init(void)
     }
   }
 
+  sli_sid_nvm3_repack_init();
+
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+  memset(kv_dir, 0, sizeof(kv_dir));
+#endif
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+  if (kv_cache_lock == NULL) {
+    kv_cache_lock = xSemaphoreCreateMutex();
+  }
+  if (kv_cache_flush_timer == NULL) {
+    kv_cache_flush_timer = xTimerCreate("kv_flush",
+                                        pdMS_TO_TICKS(SL_SIDEWALK_PAL_KV_CACHE_FLUSH_INTERVAL_MS),
+                                        pdFALSE,
+                                        NULL,
+                                        storage_kv_cache_flush_timer_cb);
+  }
+  if ((kv_cache_lock == NULL) || (kv_cache_flush_timer == NULL)) {
+    SID_PAL_LOG_ERROR("pal: kv cache init err");
+    return SID_ERROR_OOM;
+  }
+
+  for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+    kv_cache[cache_ix].group = kv_cache_group_ids[cache_ix];
+  }
+
+  // Values journaled before a reset are folded into their group objects
+  if (storage_kv_journal_load() != ECODE_NVM3_OK) {
+    SID_PAL_LOG_ERROR("pal: kv journal replay err");
+    retval = SID_ERROR_STORAGE_READ_FAIL;
+  }
+#endif
+
   uint16_t obj_cnt = (uint16_t)nvm3_enumObjects(nvm3_defaultHandle, NULL, 0, SLI_SID_NVM3_KEY_MIN_KV, SLI_SID_NVM3_KEY_MAX_KV);
   SID_PAL_LOG_INFO("pal: kv store opened with %d object(s)", obj_cnt);
 
@@ -93,18 +212,53 @@ sid_error_t sid_pal_storage_kv_init(void)
 
 sid_error_t sid_pal_storage_kv_deinit(void)
 {
+  sid_error_t retval = SID_ERROR_NONE;
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+  if (kv_cache_lock != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    retval = sli_sid_nvm3_convert_ecode_to_sid_error(storage_kv_cache_flush());
+    if (retval == SID_ERROR_NONE) {
+      for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+        sl_free(kv_cache[cache_ix].image);
+        kv_cache[cache_ix].image = NULL;
+        kv_cache[cache_ix].image_len = 0;
+        kv_cache[cache_ix].loaded = false;
+      }
+    }
+    xSemaphoreGive(kv_cache_lock);
+  }
+#endif
+
   // do not deinit default nvm3 instance as it is also used by gsdk
 
+  return retval;
+}
+
+sid_error_t sli_sid_storage_kv_flush(void)
+{
+#if SL_SIDEWALK_PAL_KV_CACHE
+  Ecode_t status = ECODE_NVM3_OK;
+
+  if (kv_cache_lock == NULL) {
+    return SID_ERROR_NONE;
+  }
+
+  xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+  status = storage_kv_cache_flush();
+  xSemaphoreGive(kv_cache_lock);
+
+  return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+#else
   return SID_ERROR_NONE;
+#endif
 }
 
 sid_error_t sid_pal_storage_kv_record_get(uint16_t group, uint16_t key, void *p_data, uint32_t len)
 {
   Ecode_t status = ECODE_NVM3_OK;
-  struct storage_kv_record_header record_header;
   size_t offset_in_object = 0;
-  uint32_t object_type;
-  size_t object_length = 0;
+  uint32_t data_size = 0;
   uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
 
   if (!SLI_SID_NVM3_VALIDATE_KEY(KV, group)) {
@@ -117,33 +271,21 @@ sid_error_t sid_pal_storage_kv_record_get(uint16_t group, uint16_t key, void *p_
     return SID_ERROR_NULL_POINTER;
   }
 
-  nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &object_length);
-
-  if (object_length > 0) {
-    while (object_length > offset_in_object) {
-      status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, &record_header, offset_in_object, STORAGE_KV_REC_HDR_SIZE);
-      if (status != ECODE_NVM3_OK) {
-        break;
-      }
-
-      if (record_header.key == key) {
-        // Record found
-        status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, p_data, offset_in_object + STORAGE_KV_REC_HDR_SIZE, len);
-        break;
-      }
+#if SL_SIDEWALK_PAL_KV_CACHE
+  struct storage_kv_cache_group *cache = storage_kv_cache_find(group);
+  if (cache != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    status = storage_kv_cache_record_get(cache, key, p_data, len, NULL);
+    xSemaphoreGive(kv_cache_lock);
+    return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+  }
+#endif
 
-      offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
-      if (object_length <= offset_in_object) {
-        status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
-        break;
-      }
-    }
+  status = storage_kv_find_record(group, key, &offset_in_object, &data_size);
 
-    if (object_length <= offset_in_object) {
-      status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
-    }
-  } else {
-    status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  if (status == ECODE_NVM3_OK) {
+    // Record found
+    status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, p_data, offset_in_object + STORAGE_KV_REC_HDR_SIZE, len);
   }
 
   return sli_sid_nvm3_convert_ecode_to_sid_error(status);
@@ -152,11 +294,8 @@ sid_error_t sid_pal_storage_kv_record_get(uint16_t group, uint16_t key, void *p_
 sid_error_t sid_pal_storage_kv_record_get_len(uint16_t group, uint16_t key, uint32_t *p_len)
 {
   Ecode_t status = ECODE_NVM3_OK;
-  struct storage_kv_record_header record_header;
   size_t offset_in_object = 0;
-  uint32_t object_type;
-  size_t object_length = 0;
-  uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
+  uint32_t data_size = 0;
 
   if (!SLI_SID_NVM3_VALIDATE_KEY(KV, group)) {
     SID_PAL_LOG_ERROR("pal: kv record get len, key 0x%.5x not in range (0x%.5x - 0x%.5x)", group, SLI_SID_NVM3_KEY_MIN_KV_REL, SLI_SID_NVM3_KEY_MAX_KV_REL);
@@ -168,37 +307,26 @@ sid_error_t sid_pal_storage_kv_record_get_len(uint16_t group, uint16_t key, uint
     return SID_ERROR_NULL_POINTER;
   }
 
-  nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &object_length);
-
-  if (object_length > 0) {
-    while (object_length > offset_in_object) {
-      status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, &record_header, offset_in_object, STORAGE_KV_REC_HDR_SIZE);
-
-      if (status != ECODE_NVM3_OK) {
-        break;
-      }
+#if SL_SIDEWALK_PAL_KV_CACHE
+  struct storage_kv_cache_group *cache = storage_kv_cache_find(group);
+  if (cache != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    status = storage_kv_cache_record_get(cache, key, NULL, 0, p_len);
+    xSemaphoreGive(kv_cache_lock);
+    return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+  }
+#endif
 
-      if (record_header.key == key) {
-        // Record found
-        *p_len = record_header.data_size;
-        break;
-      }
-      offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
-    }
+  status = storage_kv_find_record(group, key, &offset_in_object, &data_size);
 
-    if (object_length <= offset_in_object) {
-      status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
-    }
-  } else {
-    status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  if (status == ECODE_NVM3_OK) {
+    // Record found
+    *p_len = data_size;
   }
 
   return sli_sid_nvm3_convert_ecode_to_sid_error(status);
 }
 
-// "[Record] data must be aligned to a 4 byte boundary"
-// TODO:HALO-7063 - Return workaround rfds_wr_buf[256] to rfds_wr_buf[64]
-// alignas(4) static uint8_t rfds_wr_buf[256];
 sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void const *p_data, uint32_t len)
 {
   SID_PAL_ASSERT(len <= SID_PAL_KV_STORE_MAX_LENGTH_BYTES);
@@ -208,25 +336,14 @@ sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void con
     return SID_ERROR_NULL_POINTER;
   }
 
-  static uint8_t read_buf[SID_PAL_KV_STORE_MAX_LENGTH_BYTES];
-  memset(read_buf, 0, sizeof(read_buf));
-  sid_error_t sid_ret = sid_pal_storage_kv_record_get(group, key, read_buf, len);
-  // When the value to be written is already present, do nothing and return success.
-  if (sid_ret == SID_ERROR_NONE && memcmp(read_buf, p_data, len) == 0) {
-    return SID_ERROR_NONE;
-  }
-
   Ecode_t status = ECODE_NVM3_OK;
-  sid_error_t is_record_exist = SID_ERROR_NONE;
   uint32_t object_type = 0;
   size_t data_len = 0;
   size_t new_object_size = 0;
   size_t offset_in_group = 0;
+  uint32_t old_data_size = 0;
+  bool is_record_exist = false;
   uint8_t *raw_file_buffer = NULL;
-  struct storage_kv_record_header new_record_header = {
-    .key       = key,
-    .data_size = len
-  };
   uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
 
   if (!SLI_SID_NVM3_VALIDATE_KEY(KV, group)) {
@@ -234,57 +351,77 @@ sid_error_t sid_pal_storage_kv_record_set(uint16_t group, uint16_t key, void con
     return SID_ERROR_PARAM_OUT_OF_RANGE;
   }
 
+#if SL_SIDEWALK_PAL_KV_CACHE
+  struct storage_kv_cache_group *cache = storage_kv_cache_find(group);
+  if (cache != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    status = storage_kv_cache_record_set(cache, key, p_data, len);
+    xSemaphoreGive(kv_cache_lock);
+    return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+  }
+#endif
+
   status = nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
 
   if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
     // First item in the group
-    new_object_size = STORAGE_KV_REC_HDR_SIZE + len;
+    data_len = 0;
+  } else if (status != ECODE_NVM3_OK) {
+    return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+  } else if (data_len > 0) {
+    is_record_exist = (storage_kv_find_record(group, key, &offset_in_group, &old_data_size) == ECODE_NVM3_OK);
+  }
 
-    // This part is needed because NVM3 does NOT support object append at the moment!
-    raw_file_buffer = (uint8_t *)sl_calloc(new_object_size, sizeof(uint8_t));
-    if (raw_file_buffer == NULL) {
-      status = ECODE_NVM3_ERR_INT_SIZE_ERROR;
-    } else {
-      // Copy the new entry header into the buffer
-      memcpy(raw_file_buffer, &new_record_header, STORAGE_KV_REC_HDR_SIZE);
-      // Copy the actual data after the header
-      memcpy(&raw_file_buffer[STORAGE_KV_REC_HDR_SIZE], p_data, len);
+  if (is_record_exist && (old_data_size == len)) {
+    // Same length: the group image keeps its layout, only the payload is patched
+    new_object_size = data_len;
+  } else if (is_record_exist) {
+    // The record is moved to the end of the group with its new length
+    new_object_size = data_len - old_data_size + len;
+  } else {
+    new_object_size = data_len + STORAGE_KV_REC_HDR_SIZE + len;
+  }
 
-      status = nvm3_writeData(nvm3_defaultHandle, mapped_key, raw_file_buffer, new_object_size);
+  // This part is needed because NVM3 does NOT support object append or
+  // partial write at the moment! The new image is built in one buffer.
+  raw_file_buffer = (uint8_t *)sl_malloc((data_len > new_object_size) ? data_len : new_object_size);
+  if (raw_file_buffer == NULL) {
+    return sli_sid_nvm3_convert_ecode_to_sid_error(ECODE_NVM3_ERR_INT_SIZE_ERROR);
+  }
 
-      sl_free(raw_file_buffer);
-    }
-  } else if (status == ECODE_NVM3_OK) {
+  do {
     if (data_len > 0) {
-      is_record_exist = storage_kv_is_record_exist_in_group(group, key, &offset_in_group);
-
-      if (is_record_exist == SID_ERROR_NONE) {
-        sid_pal_storage_kv_record_delete(group, key);
-        nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
+      status = nvm3_readData(nvm3_defaultHandle, mapped_key, raw_file_buffer, data_len);
+      if (status != ECODE_NVM3_OK) {
+        break;
       }
     }
-    new_object_size = data_len + len + STORAGE_KV_REC_HDR_SIZE;
-    raw_file_buffer = (uint8_t *)sl_calloc(new_object_size, sizeof(uint8_t));
 
-    if (data_len > 0) {
-      status = nvm3_readData(nvm3_defaultHandle, mapped_key, raw_file_buffer, data_len);
+    // When the value to be written is already present, do nothing and return success.
+    if (is_record_exist && (old_data_size == len)
+        && (memcmp(&raw_file_buffer[offset_in_group + STORAGE_KV_REC_HDR_SIZE], p_data, len) == 0)) {
+      break;
     }
 
-    // Copy the new entry header into the buffer
-    memcpy(&raw_file_buffer[data_len], &new_record_header, STORAGE_KV_REC_HDR_SIZE);
-    // Copy the actual data after the header
-    memcpy(&raw_file_buffer[data_len + STORAGE_KV_REC_HDR_SIZE], p_data, len);
+    (void)storage_kv_image_put(raw_file_buffer,
+                               data_len,
+                               is_record_exist ? &offset_in_group : NULL,
+                               old_data_size,
+                               key,
+                               p_data,
+                               len);
 
     status = nvm3_writeData(nvm3_defaultHandle, mapped_key, raw_file_buffer, new_object_size);
 
     if (status == ECODE_OK) {
-      if (nvm3_repackNeeded(nvm3_defaultHandle)) {
-        status = nvm3_repack(nvm3_defaultHandle);
-      }
+      storage_kv_dir_update(group, raw_file_buffer, new_object_size);
+      status = sli_sid_nvm3_repack_request();
+    } else {
+      storage_kv_dir_invalidate(group);
     }
+  } while (0);
 
-    sl_free(raw_file_buffer);
-  }
+  sl_free(raw_file_buffer);
 
   return sli_sid_nvm3_convert_ecode_to_sid_error(status);
 }
@@ -298,21 +435,36 @@ sid_error_t sid_pal_storage_kv_group_delete(uint16_t group)
     return SID_ERROR_PARAM_OUT_OF_RANGE;
   }
 
+#if SL_SIDEWALK_PAL_KV_CACHE
+  struct storage_kv_cache_group *cache = storage_kv_cache_find(group);
+  if (cache != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    status = storage_kv_cache_release(cache);
+    xSemaphoreGive(kv_cache_lock);
+    if (status != ECODE_NVM3_OK) {
+      return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+    }
+  }
+#endif
+
   status = nvm3_deleteObject(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, group));
   if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
     status = ECODE_NVM3_OK;
   }
 
+  storage_kv_dir_invalidate(group);
+
   return sli_sid_nvm3_convert_ecode_to_sid_error(status);
 }
 
 sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
 {
   Ecode_t status = ECODE_NVM3_OK;
-  struct storage_kv_record_header record_header;
   uint32_t object_type = 0;
+  uint32_t record_data_size = 0;
   size_t data_len = 0;
   size_t offset_in_object = 0;
+  size_t record_size = 0;
   uint8_t *raw_file_buffer = NULL;
   uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
 
@@ -321,10 +473,29 @@ sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
     return SID_ERROR_PARAM_OUT_OF_RANGE;
   }
 
+#if SL_SIDEWALK_PAL_KV_CACHE
+  // Deletes are written through, a journal entry cannot express them
+  struct storage_kv_cache_group *cache = storage_kv_cache_find(group);
+  if (cache != NULL) {
+    xSemaphoreTake(kv_cache_lock, portMAX_DELAY);
+    status = storage_kv_cache_release(cache);
+    xSemaphoreGive(kv_cache_lock);
+    if (status != ECODE_NVM3_OK) {
+      return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+    }
+  }
+#endif
+
   do {
+    status = storage_kv_find_record(group, key, &offset_in_object, &record_data_size);
+
+    if (status != ECODE_NVM3_OK) {
+      break;
+    }
+
     status = nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
 
-    if ((status != ECODE_NVM3_OK) && (status != ECODE_NVM3_ERR_KEY_NOT_FOUND)) {
+    if (status != ECODE_NVM3_OK) {
       break;
     }
     raw_file_buffer = (uint8_t *)sl_calloc(data_len, sizeof(uint8_t));
@@ -334,59 +505,38 @@ sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
       break;
     }
 
-    while (data_len > offset_in_object) {
-      status = nvm3_readPartialData(nvm3_defaultHandle,
-                                    mapped_key,
-                                    &record_header,
-                                    offset_in_object,
-                                    STORAGE_KV_REC_HDR_SIZE);
-
-      if (status != ECODE_NVM3_OK) {
-        break;
-      }
+    record_size = STORAGE_KV_REC_HDR_SIZE + record_data_size;
 
-      if (record_header.key == key) {
-        // Record found
-        status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, raw_file_buffer, 0, offset_in_object);
+    // Record found, keep everything before and after it
+    status = nvm3_readPartialData(nvm3_defaultHandle, mapped_key, raw_file_buffer, 0, offset_in_object);
 
-        if (status != ECODE_NVM3_OK) {
-          break;
-        }
-        status = nvm3_readPartialData(nvm3_defaultHandle,
-                                      mapped_key,
-                                      &raw_file_buffer[offset_in_object],
-                                      offset_in_object + record_header.data_size + STORAGE_KV_REC_HDR_SIZE,
-                                      data_len - offset_in_object - record_header.data_size - STORAGE_KV_REC_HDR_SIZE);
-
-        if (status != ECODE_NVM3_OK) {
-          break;
-        }
-        status = nvm3_deleteObject(nvm3_defaultHandle, mapped_key);
-
-        if (status != ECODE_NVM3_OK) {
-          break;
-        }
-        status = nvm3_writeData(nvm3_defaultHandle,
-                                mapped_key,
-                                raw_file_buffer,
-                                data_len - record_header.data_size - STORAGE_KV_REC_HDR_SIZE);
-
-        if (status != ECODE_NVM3_OK) {
-          break;
-        }
-        break;
-      }
+    if (status != ECODE_NVM3_OK) {
+      break;
+    }
+    status = nvm3_readPartialData(nvm3_defaultHandle,
+                                  mapped_key,
+                                  &raw_file_buffer[offset_in_object],
+                                  offset_in_object + record_size,
+                                  data_len - offset_in_object - record_size);
 
-      offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
+    if (status != ECODE_NVM3_OK) {
+      break;
     }
+    status = nvm3_deleteObject(nvm3_defaultHandle, mapped_key);
 
-    if (data_len <= offset_in_object) {
-      status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
+    if (status != ECODE_NVM3_OK) {
+      break;
     }
+    status = nvm3_writeData(nvm3_defaultHandle,
+                            mapped_key,
+                            raw_file_buffer,
+                            data_len - record_size);
   } while (0);
 
   sl_free(raw_file_buffer);
 
+  storage_kv_dir_invalidate(group);
+
   return sli_sid_nvm3_convert_ecode_to_sid_error(status);
 }
 
@@ -394,7 +544,27 @@ sid_error_t sid_pal_storage_kv_record_delete(uint16_t group, uint16_t key)
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
-static sid_error_t storage_kv_is_record_exist_in_group(uint16_t group, uint16_t key, size_t *record_offset)
+static Ecode_t storage_kv_find_record(uint16_t group, uint16_t key, size_t *record_offset, uint32_t *data_size)
+{
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+  const struct storage_kv_dir_group *dir = storage_kv_dir_get(group);
+
+  if ((dir != NULL) && !dir->oversized) {
+    for (uint8_t record_ix = 0; record_ix < dir->record_cnt; record_ix++) {
+      if (dir->records[record_ix].key == key) {
+        *record_offset = dir->records[record_ix].offset;
+        *data_size = dir->records[record_ix].data_size;
+        return ECODE_NVM3_OK;
+      }
+    }
+    return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  }
+#endif
+
+  return storage_kv_scan_record(group, key, record_offset, data_size);
+}
+
+static Ecode_t storage_kv_scan_record(uint16_t group, uint16_t key, size_t *record_offset, uint32_t *data_size)
 {
   Ecode_t status = ECODE_NVM3_OK;
   struct storage_kv_record_header record_header;
@@ -403,16 +573,6 @@ static sid_error_t storage_kv_is_record_exist_in_group(uint16_t group, uint16_t
   size_t data_len = 0;
   uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
 
-  if (!record_offset) {
-    SID_PAL_LOG_ERROR("pal: kv record exist in group, null ptr");
-    return SID_ERROR_NULL_POINTER;
-  }
-
-  if (!SLI_SID_NVM3_VALIDATE_KEY(KV, group)) {
-    SID_PAL_LOG_ERROR("pal: kv record exist in group, key 0x%.5x not in range (0x%.5x - 0x%.5x)", group, SLI_SID_NVM3_KEY_MIN_KV_REL, SLI_SID_NVM3_KEY_MAX_KV_REL);
-    return SID_ERROR_PARAM_OUT_OF_RANGE;
-  }
-
   nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
 
   if (data_len > 0) {
@@ -430,6 +590,7 @@ static sid_error_t storage_kv_is_record_exist_in_group(uint16_t group, uint16_t
       if (record_header.key == key) {
         // Record found
         *record_offset = offset_in_object;
+        *data_size = record_header.data_size;
         break;
       }
       offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
@@ -442,5 +603,588 @@ static sid_error_t storage_kv_is_record_exist_in_group(uint16_t group, uint16_t
     status = ECODE_NVM3_ERR_KEY_NOT_FOUND;
   }
 
-  return sli_sid_nvm3_convert_ecode_to_sid_error(status);
+  return status;
+}
+
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+static const struct storage_kv_dir_group *storage_kv_dir_get(uint16_t group)
+{
+  struct storage_kv_dir_group *dir = NULL;
+  struct storage_kv_record_header record_header;
+  size_t offset_in_object = 0;
+  uint32_t object_type;
+  size_t data_len = 0;
+  uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, group);
+
+  kv_dir_use_cnt++;
+
+  for (uint8_t dir_ix = 0; dir_ix < SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM; dir_ix++) {
+    if (kv_dir[dir_ix].valid && (kv_dir[dir_ix].group == group)) {
+      kv_dir[dir_ix].last_used = kv_dir_use_cnt;
+      return &kv_dir[dir_ix];
+    }
+  }
+
+  // Not cached yet, reuse a free or the least recently used directory
+  dir = &kv_dir[0];
+  for (uint8_t dir_ix = 0; dir_ix < SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM; dir_ix++) {
+    if (!kv_dir[dir_ix].valid) {
+      dir = &kv_dir[dir_ix];
+      break;
+    }
+    if (kv_dir[dir_ix].last_used < dir->last_used) {
+      dir = &kv_dir[dir_ix];
+    }
+  }
+
+  dir->valid = false;
+  dir->oversized = false;
+  dir->group = group;
+  dir->record_cnt = 0;
+  dir->last_used = kv_dir_use_cnt;
+
+  Ecode_t status = nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
+  if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
+    // Empty group, cached as such
+    data_len = 0;
+  } else if (status != ECODE_NVM3_OK) {
+    return NULL;
+  }
+
+  while (data_len > offset_in_object) {
+    status = nvm3_readPartialData(nvm3_defaultHandle,
+                                  mapped_key,
+                                  &record_header,
+                                  offset_in_object,
+                                  STORAGE_KV_REC_HDR_SIZE);
+    if (status != ECODE_NVM3_OK) {
+      return NULL;
+    }
+
+    if (dir->record_cnt >= SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM) {
+      dir->oversized = true;
+      break;
+    }
+
+    dir->records[dir->record_cnt].key = record_header.key;
+    dir->records[dir->record_cnt].offset = (uint16_t)offset_in_object;
+    dir->records[dir->record_cnt].data_size = record_header.data_size;
+    dir->record_cnt++;
+
+    offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
+  }
+
+  dir->valid = true;
+  return dir;
+}
+#endif
+
+static void storage_kv_dir_invalidate(uint16_t group)
+{
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+  for (uint8_t dir_ix = 0; dir_ix < SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM; dir_ix++) {
+    if (kv_dir[dir_ix].valid && (kv_dir[dir_ix].group == group)) {
+      kv_dir[dir_ix].valid = false;
+    }
+  }
+#else
+  (void)group;
+#endif
+}
+
+static void storage_kv_dir_update(uint16_t group, const uint8_t *object, size_t object_length)
+{
+#if SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM > 0
+  struct storage_kv_record_header record_header;
+  size_t offset_in_object = 0;
+
+  for (uint8_t dir_ix = 0; dir_ix < SL_SIDEWALK_PAL_KV_DIR_GROUP_NUM; dir_ix++) {
+    struct storage_kv_dir_group *dir = &kv_dir[dir_ix];
+
+    if (!dir->valid || (dir->group != group)) {
+      continue;
+    }
+
+    // The group image just written is in RAM, rebuild the directory from it
+    dir->record_cnt = 0;
+    dir->oversized = false;
+    while (object_length > offset_in_object) {
+      if (dir->record_cnt >= SL_SIDEWALK_PAL_KV_DIR_RECORD_NUM) {
+        dir->oversized = true;
+        break;
+      }
+      memcpy(&record_header, &object[offset_in_object], STORAGE_KV_REC_HDR_SIZE);
+      dir->records[dir->record_cnt].key = record_header.key;
+      dir->records[dir->record_cnt].offset = (uint16_t)offset_in_object;
+      dir->records[dir->record_cnt].data_size = record_header.data_size;
+      dir->record_cnt++;
+      offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
+    }
+    break;
+  }
+#else
+  (void)group;
+  (void)object;
+  (void)object_length;
+#endif
+}
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+static Ecode_t storage_kv_image_find(const uint8_t *image, size_t image_len, uint16_t key, size_t *record_offset, uint32_t *data_size)
+{
+  struct storage_kv_record_header record_header;
+  size_t offset_in_object = 0;
+
+  while (image_len >= offset_in_object + STORAGE_KV_REC_HDR_SIZE) {
+    memcpy(&record_header, &image[offset_in_object], STORAGE_KV_REC_HDR_SIZE);
+    if (record_header.key == key) {
+      *record_offset = offset_in_object;
+      *data_size = record_header.data_size;
+      return ECODE_NVM3_OK;
+    }
+    offset_in_object += STORAGE_KV_REC_HDR_SIZE + record_header.data_size;
+  }
+
+  return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+}
+#endif
+
+static size_t storage_kv_image_put(uint8_t *image, size_t image_len, const size_t *record_offset, uint32_t old_data_size, uint16_t key, const void *p_data, uint32_t len)
+{
+  struct storage_kv_record_header record_header = {
+    .key       = key,
+    .data_size = len
+  };
+  size_t new_record_offset = image_len;
+
+  if ((record_offset != NULL) && (old_data_size == len)) {
+    // Same length: the image keeps its layout, only the payload is patched
+    memcpy(&image[*record_offset + STORAGE_KV_REC_HDR_SIZE], p_data, len);
+    return image_len;
+  }
+
+  if (record_offset != NULL) {
+    // The record is moved to the end, close the gap left by the old one
+    size_t old_record_size = STORAGE_KV_REC_HDR_SIZE + old_data_size;
+
+    memmove(&image[*record_offset],
+            &image[*record_offset + old_record_size],
+            image_len - *record_offset - old_record_size);
+    new_record_offset = image_len - old_record_size;
+  }
+
+  // Copy the new entry header into the buffer
+  memcpy(&image[new_record_offset], &record_header, STORAGE_KV_REC_HDR_SIZE);
+  // Copy the actual data after the header
+  memcpy(&image[new_record_offset + STORAGE_KV_REC_HDR_SIZE], p_data, len);
+
+  return new_record_offset + STORAGE_KV_REC_HDR_SIZE + len;
+}
+
+#if SL_SIDEWALK_PAL_KV_CACHE
+static struct storage_kv_cache_group *storage_kv_cache_find(uint16_t group)
+{
+  // Groups are written through until the cache is initialized
+  if (kv_cache_lock == NULL) {
+    return NULL;
+  }
+
+  for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+    if (kv_cache_group_ids[cache_ix] == group) {
+      return &kv_cache[cache_ix];
+    }
+  }
+
+  return NULL;
+}
+
+static Ecode_t storage_kv_cache_load(struct storage_kv_cache_group *cache)
+{
+  Ecode_t status = ECODE_NVM3_OK;
+  uint32_t object_type = 0;
+  size_t data_len = 0;
+  uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, cache->group);
+
+  if (cache->loaded) {
+    return ECODE_NVM3_OK;
+  }
+
+  status = nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
+  if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
+    // Empty group, cached as such
+    data_len = 0;
+  } else if (status != ECODE_NVM3_OK) {
+    return status;
+  }
+
+  if (data_len > 0) {
+    cache->image = (uint8_t *)sl_malloc(data_len);
+    if (cache->image == NULL) {
+      return ECODE_NVM3_ERR_INT_SIZE_ERROR;
+    }
+
+    status = nvm3_readData(nvm3_defaultHandle, mapped_key, cache->image, data_len);
+    if (status != ECODE_NVM3_OK) {
+      sl_free(cache->image);
+      cache->image = NULL;
+      return status;
+    }
+  }
+
+  cache->image_len = data_len;
+  cache->loaded = true;
+
+  return ECODE_NVM3_OK;
+}
+
+static Ecode_t storage_kv_cache_record_get(struct storage_kv_cache_group *cache, uint16_t key, void *p_data, uint32_t len, uint32_t *p_len)
+{
+  size_t record_offset = 0;
+  uint32_t data_size = 0;
+  Ecode_t status = storage_kv_cache_load(cache);
+
+  if (status == ECODE_NVM3_OK) {
+    status = storage_kv_image_find(cache->image, cache->image_len, key, &record_offset, &data_size);
+  }
+
+  if (status != ECODE_NVM3_OK) {
+    return status;
+  }
+
+  if (p_len != NULL) {
+    *p_len = data_size;
+  }
+
+  if (p_data != NULL) {
+    // Same bound as a partial read of the group object
+    if ((record_offset + STORAGE_KV_REC_HDR_SIZE + len) > cache->image_len) {
+      return ECODE_NVM3_ERR_READ_DATA_SIZE;
+    }
+    memcpy(p_data, &cache->image[record_offset + STORAGE_KV_REC_HDR_SIZE], len);
+  }
+
+  return ECODE_NVM3_OK;
+}
+
+static Ecode_t storage_kv_cache_record_set(struct storage_kv_cache_group *cache, uint16_t key, const void *p_data, uint32_t len)
+{
+  size_t record_offset = 0;
+  uint32_t old_data_size = 0;
+  bool is_record_exist = false;
+  bool is_dirty = false;
+  Ecode_t status = storage_kv_cache_load(cache);
+
+  if (status != ECODE_NVM3_OK) {
+    return status;
+  }
+
+  is_record_exist = (storage_kv_image_find(cache->image, cache->image_len, key, &record_offset, &old_data_size) == ECODE_NVM3_OK);
+
+  // When the value to be written is already present, do nothing and return success.
+  if (is_record_exist && (old_data_size == len)
+      && (memcmp(&cache->image[record_offset + STORAGE_KV_REC_HDR_SIZE], p_data, len) == 0)) {
+    return ECODE_NVM3_OK;
+  }
+
+  for (uint8_t dirty_ix = 0; dirty_ix < cache->dirty_cnt; dirty_ix++) {
+    if (cache->dirty_keys[dirty_ix] == key) {
+      is_dirty = true;
+      break;
+    }
+  }
+
+  if (!is_dirty && (cache->dirty_cnt >= SL_SIDEWALK_PAL_KV_CACHE_DIRTY_RECORD_NUM)) {
+    // No room to track one more record, write back the pending ones first
+    status = storage_kv_cache_flush();
+    if (status != ECODE_NVM3_OK) {
+      return status;
+    }
+  }
+
+  if (is_record_exist && (old_data_size == len)) {
+    (void)storage_kv_image_put(cache->image, cache->image_len, &record_offset, old_data_size, key, p_data, len);
+  } else {
+    size_t new_image_len = cache->image_len + STORAGE_KV_REC_HDR_SIZE + len;
+    uint8_t *image = NULL;
+
+    if (is_record_exist) {
+      new_image_len -= STORAGE_KV_REC_HDR_SIZE + old_data_size;
+    }
+
+    image = (uint8_t *)sl_malloc((cache->image_len > new_image_len) ? cache->image_len : new_image_len);
+    if (image == NULL) {
+      return ECODE_NVM3_ERR_INT_SIZE_ERROR;
+    }
+    if (cache->image_len > 0) {
+      memcpy(image, cache->image, cache->image_len);
+    }
+
+    new_image_len = storage_kv_image_put(image,
+                                         cache->image_len,
+                                         is_record_exist ? &record_offset : NULL,
+                                         old_data_size,
+                                         key,
+                                         p_data,
+                                         len);
+    sl_free(cache->image);
+    cache->image = image;
+    cache->image_len = new_image_len;
+  }
+
+  if (!is_dirty) {
+    cache->dirty_keys[cache->dirty_cnt++] = key;
+  }
+
+  // A running timer is not restarted, so a busy group is still flushed in time
+  if (xTimerIsTimerActive(kv_cache_flush_timer) == pdFALSE) {
+    (void)xTimerStart(kv_cache_flush_timer, 0);
+  }
+
+  return ECODE_NVM3_OK;
+}
+
+static Ecode_t storage_kv_cache_release(struct storage_kv_cache_group *cache)
+{
+  Ecode_t status = storage_kv_cache_flush();
+
+  // Journal entries of the group would be replayed over a direct change
+  if ((status == ECODE_NVM3_OK) && (kv_journal_len > 0)) {
+    status = storage_kv_journal_replay(kv_journal, kv_journal_len);
+    if (status == ECODE_NVM3_OK) {
+      kv_journal_len = 0;
+    }
+  }
+
+  if (status == ECODE_NVM3_OK) {
+    sl_free(cache->image);
+    cache->image = NULL;
+    cache->image_len = 0;
+    cache->loaded = false;
+  }
+
+  return status;
+}
+
+static Ecode_t storage_kv_cache_flush(void)
+{
+  Ecode_t status = ECODE_NVM3_OK;
+  struct storage_kv_journal_entry entry;
+  size_t record_offset = 0;
+  uint32_t data_size = 0;
+  size_t entries_len = 0;
+  size_t journal_len = 0;
+
+  for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+    for (uint8_t dirty_ix = 0; dirty_ix < kv_cache[cache_ix].dirty_cnt; dirty_ix++) {
+      if (storage_kv_image_find(kv_cache[cache_ix].image,
+                                kv_cache[cache_ix].image_len,
+                                kv_cache[cache_ix].dirty_keys[dirty_ix],
+                                &record_offset,
+                                &data_size) == ECODE_NVM3_OK) {
+        entries_len += STORAGE_KV_JOURNAL_ENTRY_SIZE + data_size;
+      }
+    }
+  }
+
+  if (entries_len == 0) {
+    return ECODE_NVM3_OK;
+  }
+
+  if ((kv_journal_len + entries_len) > SL_SIDEWALK_PAL_KV_JOURNAL_SIZE) {
+    // Journal full, fold it into the group objects and start over
+    status = storage_kv_journal_replay(kv_journal, kv_journal_len);
+    if (status != ECODE_NVM3_OK) {
+      return status;
+    }
+    kv_journal_len = 0;
+  }
+
+  if (entries_len <= SL_SIDEWALK_PAL_KV_JOURNAL_SIZE) {
+    // Append the dirty records, the journal object is the only one written
+    journal_len = kv_journal_len;
+    for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+      for (uint8_t dirty_ix = 0; dirty_ix < kv_cache[cache_ix].dirty_cnt; dirty_ix++) {
+        entry.group = kv_cache[cache_ix].group;
+        entry.key = kv_cache[cache_ix].dirty_keys[dirty_ix];
+        if (storage_kv_image_find(kv_cache[cache_ix].image,
+                                  kv_cache[cache_ix].image_len,
+                                  entry.key,
+                                  &record_offset,
+                                  &entry.data_size) != ECODE_NVM3_OK) {
+          continue;
+        }
+        memcpy(&kv_journal[journal_len], &entry, STORAGE_KV_JOURNAL_ENTRY_SIZE);
+        memcpy(&kv_journal[journal_len + STORAGE_KV_JOURNAL_ENTRY_SIZE],
+               &kv_cache[cache_ix].image[record_offset + STORAGE_KV_REC_HDR_SIZE],
+               entry.data_size);
+        journal_len += STORAGE_KV_JOURNAL_ENTRY_SIZE + entry.data_size;
+      }
+    }
+
+    status = nvm3_writeData(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, SLI_SID_NVM3_KV_JOURNAL_GROUP), kv_journal, journal_len);
+    if (status == ECODE_NVM3_OK) {
+      kv_journal_len = journal_len;
+      for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+        kv_cache[cache_ix].dirty_cnt = 0;
+      }
+    }
+  } else {
+    // More dirty data than the journal holds, the groups are written as a whole
+    for (size_t cache_ix = 0; cache_ix < STORAGE_KV_CACHE_GROUP_NUM; cache_ix++) {
+      if (kv_cache[cache_ix].dirty_cnt == 0) {
+        continue;
+      }
+      status = nvm3_writeData(nvm3_defaultHandle,
+                              SLI_SID_NVM3_MAP_KEY(KV, kv_cache[cache_ix].group),
+                              kv_cache[cache_ix].image,
+                              kv_cache[cache_ix].image_len);
+      storage_kv_dir_invalidate(kv_cache[cache_ix].group);
+      if (status != ECODE_NVM3_OK) {
+        break;
+      }
+      kv_cache[cache_ix].dirty_cnt = 0;
+    }
+  }
+
+  if (status == ECODE_NVM3_OK) {
+    status = sli_sid_nvm3_repack_request();
+  }
+
+  return status;
+}
+
+static void storage_kv_cache_flush_timer_cb(TimerHandle_t timer)
+{
+  (void)timer;
+
+  if (sli_sid_storage_kv_flush() != SID_ERROR_NONE) {
+    SID_PAL_LOG_ERROR("pal: kv cache flush err");
+  }
+}
+
+static Ecode_t storage_kv_journal_replay(const uint8_t *journal, size_t journal_len)
+{
+  Ecode_t status = ECODE_NVM3_OK;
+  struct storage_kv_journal_entry entry;
+  struct storage_kv_journal_entry group_entry;
+  size_t entry_offset = 0;
+
+  while ((status == ECODE_NVM3_OK) && ((entry_offset + STORAGE_KV_JOURNAL_ENTRY_SIZE) <= journal_len)) {
+    uint32_t object_type = 0;
+    size_t data_len = 0;
+    size_t image_len = 0;
+    size_t offset = 0;
+    bool is_group_done = false;
+    uint8_t *image = NULL;
+
+    memcpy(&entry, &journal[entry_offset], STORAGE_KV_JOURNAL_ENTRY_SIZE);
+
+    // A group is folded in one write when its first entry is met
+    while (offset < entry_offset) {
+      memcpy(&group_entry, &journal[offset], STORAGE_KV_JOURNAL_ENTRY_SIZE);
+      if (group_entry.group == entry.group) {
+        is_group_done = true;
+        break;
+      }
+      offset += STORAGE_KV_JOURNAL_ENTRY_SIZE + group_entry.data_size;
+    }
+    entry_offset += STORAGE_KV_JOURNAL_ENTRY_SIZE + entry.data_size;
+    if (is_group_done || (entry_offset > journal_len)) {
+      continue;
+    }
+
+    status = nvm3_getObjectInfo(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, entry.group), &object_type, &data_len);
+    if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
+      data_len = 0;
+    } else if (status != ECODE_NVM3_OK) {
+      break;
+    }
+
+    // Every entry grows the group object by its own size at most
+    image = (uint8_t *)sl_malloc(data_len + journal_len);
+    if (image == NULL) {
+      status = ECODE_NVM3_ERR_INT_SIZE_ERROR;
+      break;
+    }
+
+    status = (data_len > 0) ? nvm3_readData(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, entry.group), image, data_len) : ECODE_NVM3_OK;
+    image_len = data_len;
+
+    offset = 0;
+    while ((status == ECODE_NVM3_OK) && ((offset + STORAGE_KV_JOURNAL_ENTRY_SIZE) <= journal_len)) {
+      size_t record_offset = 0;
+      uint32_t old_data_size = 0;
+
+      memcpy(&group_entry, &journal[offset], STORAGE_KV_JOURNAL_ENTRY_SIZE);
+      if ((offset + STORAGE_KV_JOURNAL_ENTRY_SIZE + group_entry.data_size) > journal_len) {
+        break;
+      }
+      if (group_entry.group == entry.group) {
+        bool is_record_exist = (storage_kv_image_find(image, image_len, group_entry.key, &record_offset, &old_data_size) == ECODE_NVM3_OK);
+
+        image_len = storage_kv_image_put(image,
+                                         image_len,
+                                         is_record_exist ? &record_offset : NULL,
+                                         old_data_size,
+                                         group_entry.key,
+                                         &journal[offset + STORAGE_KV_JOURNAL_ENTRY_SIZE],
+                                         group_entry.data_size);
+      }
+      offset += STORAGE_KV_JOURNAL_ENTRY_SIZE + group_entry.data_size;
+    }
+
+    if (status == ECODE_NVM3_OK) {
+      status = nvm3_writeData(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, entry.group), image, image_len);
+    }
+    storage_kv_dir_invalidate(entry.group);
+    sl_free(image);
+  }
+
+  if (status == ECODE_NVM3_OK) {
+    status = nvm3_deleteObject(nvm3_defaultHandle, SLI_SID_NVM3_MAP_KEY(KV, SLI_SID_NVM3_KV_JOURNAL_GROUP));
+    if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
+      status = ECODE_NVM3_OK;
+    }
+  }
+
+  if (status == ECODE_NVM3_OK) {
+    status = sli_sid_nvm3_repack_request();
+  }
+
+  return status;
+}
+
+static Ecode_t storage_kv_journal_load(void)
+{
+  Ecode_t status = ECODE_NVM3_OK;
+  uint32_t object_type = 0;
+  size_t data_len = 0;
+  uint8_t *journal = NULL;
+  uint32_t mapped_key = SLI_SID_NVM3_MAP_KEY(KV, SLI_SID_NVM3_KV_JOURNAL_GROUP);
+
+  kv_journal_len = 0;
+
+  status = nvm3_getObjectInfo(nvm3_defaultHandle, mapped_key, &object_type, &data_len);
+  if (status == ECODE_NVM3_ERR_KEY_NOT_FOUND) {
+    return ECODE_NVM3_OK;
+  } else if (status != ECODE_NVM3_OK) {
+    return status;
+  }
+
+  // Not read into kv_journal, the object may come from a larger configuration
+  journal = (uint8_t *)sl_malloc(data_len);
+  if (journal == NULL) {
+    return ECODE_NVM3_ERR_INT_SIZE_ERROR;
+  }
+
+  status = nvm3_readData(nvm3_defaultHandle, mapped_key, journal, data_len);
+  if (status == ECODE_NVM3_OK) {
+    status = storage_kv_journal_replay(journal, data_len);
+  }
+  sl_free(journal);
+
+  SID_PAL_LOG_INFO("pal: kv journal replayed (%u bytes): %d", (unsigned)data_len, status);
+
+  return status;
 }
+#endif
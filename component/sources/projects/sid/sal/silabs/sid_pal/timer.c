@@ -40,29 +40,69 @@
 // -----------------------------------------------------------------------------
 #include <sid_pal_timer_ifc.h>
 #include <sid_pal_uptime_ifc.h>
-#include <sid_pal_log_ifc.h>
+#include "log_module.h"
 #include <sid_pal_assert_ifc.h>
 #include <sid_time_ops.h>
 #include <string.h>
-#include <math.h>
+#include <em_core.h>
+#include "sl_sidewalk_pal_config.h"
+#include "timer_stats.h"
+#include "uptime.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
-// RAIL does not allow to set timers for more than ~3221 seconds
-#define RAIL_MAX_ALLOWED_TIMEOUT_VAL_SEC ((((~((uint32_t)0) / 4U) * 3U) / SID_TIME_USEC_PER_SEC) - 1)
+#define SLI_SID_PAL_LOG_MODULE_LEVEL SL_SIDEWALK_PAL_LOG_LEVEL_TIMER
+
+// Longest timeout the hardware timer is started with, later deadlines are reached in steps
+#define TIMER_HW_MAX_TIMEOUT_TICKS  (UINT32_MAX / 2U)
+
+// Armed timers of one priority class, min-heap ordered by expiry tick
+typedef struct {
+  sid_pal_timer_t *timers[SL_SIDEWALK_PAL_TIMER_HEAP_SIZE];
+  uint16_t count;
+} timer_heap_t;
+
+enum {
+  TIMER_HEAP_PRECISE = 0,
+  TIMER_HEAP_LOWPOWER,
+  TIMER_HEAP_NUM
+};
+
+typedef struct {
+  uint32_t arms;
+  uint32_t fires;
+  uint32_t coalesced_fires;
+  uint64_t lateness_ticks;
+  uint32_t max_lateness_ticks;
+} timer_class_stats_t;
 
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
 /*******************************************************************************
- * Sleeptimer callback to call the proper timer objects callback with argument
+ * Sleeptimer callback dispatching all expired timer objects
  ******************************************************************************/
 static void sleeptimer_callback(sl_sleeptimer_timer_handle_t * handle,
                                 void * data);
 
+/*******************************************************************************
+ * Starts the sleeptimer for the earliest deadline of the armed timer objects
+ ******************************************************************************/
+static void timer_schedule(void);
+
+/*******************************************************************************
+ * Calls the callback of every expired timer object
+ ******************************************************************************/
+static void timer_dispatch(bool is_scheduled);
+
+static bool timer_heap_insert(timer_heap_t * heap, sid_pal_timer_t * timer);
+static void timer_heap_remove(timer_heap_t * heap, uint16_t index);
+static void timer_heap_sift_up(timer_heap_t * heap, uint16_t index);
+static void timer_heap_sift_down(timer_heap_t * heap, uint16_t index);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -71,6 +111,17 @@ static void sleeptimer_callback(sl_sleeptimer_timer_handle_t * handle,
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static timer_heap_t timer_heaps[TIMER_HEAP_NUM];
+// The only sleeptimer used by the sid_pal_timer objects
+static sl_sleeptimer_timer_handle_t sleeptimer_handle;
+static uint64_t sleeptimer_wakeup_tick = UINT64_MAX;
+// The sleeptimer was pulled forward by an other wakeup source
+static bool sleeptimer_aligned = false;
+// Dispatch in progress, the timer callbacks may arm or cancel timers
+static uint8_t dispatch_depth = 0;
+static uint32_t timer_wakeups = 0;
+static timer_class_stats_t timer_stats[TIMER_HEAP_NUM];
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -95,6 +146,8 @@ sid_error_t sid_pal_timer_init(sid_pal_timer_t * timer,
   timer->callback_arg = event_callback_arg;
   timer->alarm = SID_TIME_INFINITY;
   timer->period = SID_TIME_INFINITY;
+  timer->is_periodic = false;
+  timer->heap_pos = 0;
   return SID_ERROR_NONE;
 }
 
@@ -112,12 +165,9 @@ sid_error_t sid_pal_timer_deinit(sid_pal_timer_t * timer)
   if (!timer) {
     return SID_ERROR_INVALID_ARGS;
   }
-  bool running = false;
-  sl_sleeptimer_is_timer_running(&(timer->sleeptimer_handle), &running);
 
-  if (running) {
-    sl_sleeptimer_stop_timer(&(timer->sleeptimer_handle));
-  }
+  (void)sid_pal_timer_cancel(timer);
+
   timer->callback = NULL;
   timer->callback_arg = NULL;
   timer->alarm = SID_TIME_ZERO;
@@ -144,6 +194,8 @@ sid_error_t sid_pal_timer_arm(sid_pal_timer_t * timer,
                               const struct sid_timespec * when,
                               const struct sid_timespec * period)
 {
+  sid_error_t retval = SID_ERROR_NONE;
+
   if (!timer || !when) {
     return SID_ERROR_INVALID_ARGS;
   }
@@ -151,59 +203,35 @@ sid_error_t sid_pal_timer_arm(sid_pal_timer_t * timer,
   if (sid_pal_timer_is_armed(timer)) {
     return SID_ERROR_INVALID_ARGS;
   }
-  timer->alarm =  *when;
+  timer->alarm = *when;
+  timer->is_periodic = false;
 
-  if (period != NULL) {
+  if ((period != NULL) && !sid_time_is_infinity(period) && !sid_time_is_zero(period)) {
     timer->period = *period;
     timer->is_periodic = true;
-    timer->has_started = false;
-  }
-  uint8_t priority = 0;
-
-  switch (type) {
-    case SID_PAL_TIMER_PRIO_CLASS_PRECISE:
-      priority = 0;
-      break;
-
-    case SID_PAL_TIMER_PRIO_CLASS_LOWPOWER:
-      priority = 10;
-      break;
-
-    default:
-      break;
   }
 
-  volatile uint64_t timeout_tick = 0;
-  volatile uint64_t timeout_us = 0;
-  struct sid_timespec up_time;
-  struct sid_timespec alarm_cp = timer->alarm;
-
-  up_time.tv_nsec = 0;
-  up_time.tv_sec = 0;
+  // LOWPOWER timers may expire late to share a wakeup, PRECISE ones may not
+  timer->prio_class = (type == SID_PAL_TIMER_PRIO_CLASS_LOWPOWER) ? TIMER_HEAP_LOWPOWER : TIMER_HEAP_PRECISE;
+  timer->expiry_tick = sli_sid_pal_uptime_to_tick(&timer->alarm);
 
-  if (period != NULL) {
-    timer->period_in_ms = (timer->period.tv_sec * 1000) + (timer->period.tv_nsec / 1000000);
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  timer_stats[timer->prio_class].arms++;
+  if (timer_heap_insert(&timer_heaps[timer->prio_class], timer)) {
+    // Timers armed from a callback are scheduled once the dispatch is over
+    if (dispatch_depth == 0) {
+      timer_schedule();
+    }
+  } else {
+    retval = SID_ERROR_OUT_OF_RESOURCES;
   }
+  CORE_EXIT_ATOMIC();
 
-  sid_pal_uptime_now(&up_time);
-
-  // from here to sl_sleeptimer_start_timer it takes around 6 us, so
-  // we add this offset value to uptime value to avoid arming the timer with
-  // a value in the past
-  up_time.tv_nsec += 6000;
-
-  if (sid_time_gt(&alarm_cp, &up_time)) {
-    // arm a one-shot timer first to handle the first timer arming which is supposed to be a bit shorter
-    // than the period due to code execution time between the caller and the actual timer start (a few lines below)
-    sid_time_sub(&alarm_cp, &up_time);
-    timeout_us = (alarm_cp.tv_sec * 1000000) + (alarm_cp.tv_nsec / 1000);       // convert from sid_timespec to us
-    timeout_tick = ((timeout_us * 32768) + 999999) / 1000000;                   // convert from us to tick and round up
-  }
-  int status = sl_sleeptimer_start_timer(&(timer->sleeptimer_handle), timeout_tick, sleeptimer_callback, timer, priority, 0);
-  if (status != SID_ERROR_NONE) {
+  if (retval != SID_ERROR_NONE) {
     SID_PAL_LOG_ERROR("pal: arm timer failed");
   }
-  return SID_ERROR_NONE;
+  return retval;
 }
 
 /*******************************************************************************
@@ -221,9 +249,15 @@ sid_error_t sid_pal_timer_cancel(sid_pal_timer_t * timer)
     return SID_ERROR_INVALID_ARGS;
   }
 
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
   if (sid_pal_timer_is_armed(timer)) {
-    sl_sleeptimer_stop_timer(&(timer->sleeptimer_handle));
+    timer_heap_remove(&timer_heaps[timer->prio_class], (uint16_t)(timer->heap_pos - 1U));
+    if (dispatch_depth == 0) {
+      timer_schedule();
+    }
   }
+  CORE_EXIT_ATOMIC();
   return SID_ERROR_NONE;
 }
 
@@ -238,10 +272,7 @@ sid_error_t sid_pal_timer_cancel(sid_pal_timer_t * timer)
  ******************************************************************************/
 bool sid_pal_timer_is_armed(const sid_pal_timer_t * timer)
 {
-  bool running = false;
-
-  sl_sleeptimer_is_timer_running(&(((sid_pal_timer_t *)timer)->sleeptimer_handle), &running);
-  return running;
+  return (timer != NULL) && (timer->heap_pos != 0);
 }
 
 /*******************************************************************************
@@ -271,12 +302,96 @@ void sid_pal_timer_event_callback(void * arg,
   (void)(now);
 }
 
+void sli_sid_pal_timer_align_wakeup(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  uint64_t now = sl_sleeptimer_get_tick_count64();
+  const timer_heap_t *heap = &timer_heaps[TIMER_HEAP_LOWPOWER];
+
+  // The timers are still dispatched from the sleeptimer callback only, so
+  // the callbacks stay serialized in one context
+  if ((dispatch_depth == 0)
+      && (heap->count > 0)
+      && (heap->timers[0]->expiry_tick <= now)
+      && (sleeptimer_wakeup_tick > now)) {
+    (void)sl_sleeptimer_stop_timer(&sleeptimer_handle);
+    sl_status_t status = sl_sleeptimer_start_timer(&sleeptimer_handle, 0, sleeptimer_callback, NULL, 0, 0);
+    if (status == SL_STATUS_OK) {
+      sleeptimer_wakeup_tick = now;
+      sleeptimer_aligned = true;
+    } else {
+      sleeptimer_wakeup_tick = UINT64_MAX;
+      timer_schedule();
+    }
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void sli_sid_pal_timer_xtal_ppm_changed(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  // The conversion is monotonic, the heaps stay ordered
+  for (uint8_t heap_ix = 0; heap_ix < TIMER_HEAP_NUM; heap_ix++) {
+    for (uint16_t ix = 0; ix < timer_heaps[heap_ix].count; ix++) {
+      sid_pal_timer_t *timer = timer_heaps[heap_ix].timers[ix];
+      timer->expiry_tick = sli_sid_pal_uptime_to_tick(&timer->alarm);
+    }
+  }
+  if (dispatch_depth == 0) {
+    timer_schedule();
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void sli_sid_pal_timer_get_stats(sli_sid_pal_timer_stats_t * stats)
+{
+  sli_sid_pal_timer_class_stats_t *class_stats[TIMER_HEAP_NUM];
+  uint64_t ticks_per_sec = sl_sleeptimer_get_timer_frequency();
+
+  if (stats == NULL) {
+    return;
+  }
+
+  class_stats[TIMER_HEAP_PRECISE] = &stats->precise;
+  class_stats[TIMER_HEAP_LOWPOWER] = &stats->lowpower;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  stats->wakeups = timer_wakeups;
+  for (uint8_t heap_ix = 0; heap_ix < TIMER_HEAP_NUM; heap_ix++) {
+    const timer_class_stats_t *counters = &timer_stats[heap_ix];
+
+    class_stats[heap_ix]->arms = counters->arms;
+    class_stats[heap_ix]->fires = counters->fires;
+    class_stats[heap_ix]->coalesced_fires = counters->coalesced_fires;
+    class_stats[heap_ix]->armed = timer_heaps[heap_ix].count;
+    class_stats[heap_ix]->avg_lateness_us = 0;
+    if (counters->fires > 0) {
+      class_stats[heap_ix]->avg_lateness_us = (uint32_t)((counters->lateness_ticks * SID_TIME_USEC_PER_SEC)
+                                                         / (counters->fires * ticks_per_sec));
+    }
+    class_stats[heap_ix]->max_lateness_us = (uint32_t)(((uint64_t)counters->max_lateness_ticks * SID_TIME_USEC_PER_SEC) / ticks_per_sec);
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void sli_sid_pal_timer_reset_stats(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  timer_wakeups = 0;
+  memset(timer_stats, 0, sizeof(timer_stats));
+  CORE_EXIT_ATOMIC();
+}
+
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
 
 /*******************************************************************************
- * Sleeptimer callback to call the proper timer objects callback with argument
+ * Sleeptimer callback dispatching all expired timer objects
  * @param handle Which sleeptimer called this callback
  * @param data Data which was given in when timer was started
  ******************************************************************************/
@@ -284,11 +399,206 @@ static void sleeptimer_callback(sl_sleeptimer_timer_handle_t * handle,
                                 void * data)
 {
   (void)(handle);
-  sid_pal_timer_t * timer = (sid_pal_timer_t *)data;
-  if (timer->is_periodic && !timer->has_started) {
-    timer->has_started = true;
-    sl_status_t ret = sl_sleeptimer_start_periodic_timer_ms(&(timer->sleeptimer_handle), timer->period_in_ms, sleeptimer_callback, timer, 0, 0);
-    SID_PAL_ASSERT(ret == SL_STATUS_OK);
+  (void)(data);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  bool is_scheduled = !sleeptimer_aligned;
+  sleeptimer_aligned = false;
+  CORE_EXIT_ATOMIC();
+
+  timer_dispatch(is_scheduled);
+}
+
+/*******************************************************************************
+ * Calls the callback of every expired timer object, in deadline order. Only
+ * called from the sleeptimer callback.
+ * @param[in] is_scheduled true if the sleeptimer woke up for the earliest
+ *                         deadline, false if it was pulled forward by an other
+ *                         wakeup source
+ ******************************************************************************/
+static void timer_dispatch(bool is_scheduled)
+{
+  uint32_t dispatched = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  dispatch_depth++;
+  sleeptimer_wakeup_tick = UINT64_MAX;
+  if (is_scheduled) {
+    timer_wakeups++;
+  }
+
+  while (1) {
+    uint64_t now = sl_sleeptimer_get_tick_count64();
+    uint8_t heap_ix = TIMER_HEAP_NUM;
+
+    for (uint8_t ix = TIMER_HEAP_PRECISE; ix < TIMER_HEAP_NUM; ix++) {
+      if ((timer_heaps[ix].count > 0)
+          && (timer_heaps[ix].timers[0]->expiry_tick <= now)
+          && ((heap_ix == TIMER_HEAP_NUM)
+              || (timer_heaps[ix].timers[0]->expiry_tick < timer_heaps[heap_ix].timers[0]->expiry_tick))) {
+        heap_ix = ix;
+      }
+    }
+    if (heap_ix == TIMER_HEAP_NUM) {
+      break;
+    }
+
+    timer_heap_t *heap = &timer_heaps[heap_ix];
+    sid_pal_timer_t *timer = heap->timers[0];
+    uint64_t lateness_ticks = now - timer->expiry_tick;
+
+    timer_stats[heap_ix].fires++;
+    timer_stats[heap_ix].lateness_ticks += lateness_ticks;
+    if (lateness_ticks > timer_stats[heap_ix].max_lateness_ticks) {
+      timer_stats[heap_ix].max_lateness_ticks = (uint32_t)lateness_ticks;
+    }
+    // Only the first timer of a scheduled wakeup is the reason of the wakeup
+    if (!is_scheduled || (dispatched > 0)) {
+      timer_stats[heap_ix].coalesced_fires++;
+    }
+    dispatched++;
+
+    timer_heap_remove(heap, 0);
+    if (timer->is_periodic) {
+      // Re-armed before the callback, which is allowed to cancel it
+      sid_time_add(&timer->alarm, &timer->period);
+      timer->expiry_tick = sli_sid_pal_uptime_to_tick(&timer->alarm);
+      bool inserted = timer_heap_insert(heap, timer);
+      SID_PAL_ASSERT(inserted);
+      (void)inserted;
+    }
+
+    CORE_EXIT_ATOMIC();
+    timer->callback(timer->callback_arg, timer);
+    CORE_ENTER_ATOMIC();
+  }
+
+  dispatch_depth--;
+  if (dispatch_depth == 0) {
+    timer_schedule();
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/*******************************************************************************
+ * Starts the sleeptimer for the earliest deadline of the armed timer objects.
+ * The LOWPOWER deadline is delayed by the configured slack, so every LOWPOWER
+ * timer expiring within the slack, or before a PRECISE deadline, is served by
+ * the same wakeup. Has to be called in atomic section.
+ ******************************************************************************/
+static void timer_schedule(void)
+{
+  uint64_t wakeup_tick = UINT64_MAX;
+  uint64_t now = 0;
+  uint64_t timeout_tick = 0;
+
+  if (timer_heaps[TIMER_HEAP_PRECISE].count > 0) {
+    wakeup_tick = timer_heaps[TIMER_HEAP_PRECISE].timers[0]->expiry_tick;
+  }
+  if (timer_heaps[TIMER_HEAP_LOWPOWER].count > 0) {
+    uint64_t lowpower_tick = timer_heaps[TIMER_HEAP_LOWPOWER].timers[0]->expiry_tick
+                             + sl_sleeptimer_ms_to_tick(SL_SIDEWALK_PAL_TIMER_LOWPOWER_SLACK_MS);
+    if (lowpower_tick < wakeup_tick) {
+      wakeup_tick = lowpower_tick;
+    }
+  }
+
+  if (wakeup_tick == sleeptimer_wakeup_tick) {
+    // Already started for this deadline
+    return;
+  }
+
+  (void)sl_sleeptimer_stop_timer(&sleeptimer_handle);
+  sleeptimer_wakeup_tick = wakeup_tick;
+  if (wakeup_tick == UINT64_MAX) {
+    return;
+  }
+
+  now = sl_sleeptimer_get_tick_count64();
+  if (wakeup_tick > now) {
+    timeout_tick = wakeup_tick - now;
+    if (timeout_tick > TIMER_HW_MAX_TIMEOUT_TICKS) {
+      timeout_tick = TIMER_HW_MAX_TIMEOUT_TICKS;
+    }
+  }
+
+  sl_status_t status = sl_sleeptimer_start_timer(&sleeptimer_handle, (uint32_t)timeout_tick, sleeptimer_callback, NULL, 0, 0);
+  if (status != SL_STATUS_OK) {
+    sleeptimer_wakeup_tick = UINT64_MAX;
+    SID_PAL_LOG_ERROR("pal: timer schedule failed: %d", status);
+  }
+}
+
+static bool timer_heap_insert(timer_heap_t * heap, sid_pal_timer_t * timer)
+{
+  if (heap->count >= SL_SIDEWALK_PAL_TIMER_HEAP_SIZE) {
+    return false;
+  }
+
+  heap->timers[heap->count] = timer;
+  heap->count++;
+  timer_heap_sift_up(heap, (uint16_t)(heap->count - 1U));
+
+  return true;
+}
+
+static void timer_heap_remove(timer_heap_t * heap, uint16_t index)
+{
+  sid_pal_timer_t *timer = heap->timers[index];
+
+  heap->count--;
+  if (index != heap->count) {
+    // The last timer takes the free place and is moved to its position
+    sid_pal_timer_t *moved = heap->timers[heap->count];
+
+    heap->timers[index] = moved;
+    timer_heap_sift_down(heap, index);
+    timer_heap_sift_up(heap, (uint16_t)(moved->heap_pos - 1U));
+  }
+  timer->heap_pos = 0;
+}
+
+static void timer_heap_sift_up(timer_heap_t * heap, uint16_t index)
+{
+  sid_pal_timer_t *timer = heap->timers[index];
+
+  while (index > 0) {
+    uint16_t parent = (uint16_t)((index - 1U) / 2U);
+
+    if (heap->timers[parent]->expiry_tick <= timer->expiry_tick) {
+      break;
+    }
+    heap->timers[index] = heap->timers[parent];
+    heap->timers[index]->heap_pos = (uint16_t)(index + 1U);
+    index = parent;
+  }
+  heap->timers[index] = timer;
+  timer->heap_pos = (uint16_t)(index + 1U);
+}
+
+static void timer_heap_sift_down(timer_heap_t * heap, uint16_t index)
+{
+  sid_pal_timer_t *timer = heap->timers[index];
+
+  while (1) {
+    uint16_t child = (uint16_t)((2U * index) + 1U);
+
+    if (child >= heap->count) {
+      break;
+    }
+    if (((child + 1U) < heap->count)
+        && (heap->timers[child + 1U]->expiry_tick < heap->timers[child]->expiry_tick)) {
+      child++;
+    }
+    if (timer->expiry_tick <= heap->timers[child]->expiry_tick) {
+      break;
+    }
+    heap->timers[index] = heap->timers[child];
+    heap->timers[index]->heap_pos = (uint16_t)(index + 1U);
+    index = child;
   }
-  timer->callback(timer->callback_arg, (sid_pal_timer_t *)timer);
+  heap->timers[index] = timer;
+  timer->heap_pos = (uint16_t)(index + 1U);
 }
@@ -43,15 +43,58 @@
 #include <sid_pal_assert_ifc.h>
 #include <sl_sleeptimer.h>
 #include <sid_time_ops.h>
+#include <em_core.h>
+#include <sl_common.h>
+#include "uptime.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 
+#define UPTIME_PPM_SCALE              1000000LL
+// floor(2^48 / 10^9), reciprocal of the nanoseconds of a second
+#define UPTIME_NSEC_RECIPROCAL_Q48    281474ULL
+// Longest time converted from the conversion base, keeps the fast path products in 64 bits
+#define UPTIME_REBASE_MAX_SEC         65536ULL
+#define UPTIME_REBASE_MAX_TICKS       (1ULL << 31)
+
+typedef struct {
+  uint64_t base_tick;               // sleeptimer tick of the conversion base
+  struct sid_timespec base_time;    // compensated uptime at base_tick
+  uint64_t nsec_per_tick_q32;       // compensated tick period in Q32 nanoseconds
+  uint64_t rebase_ticks;            // ticks after which the conversion base is moved forward
+  uint32_t ticks_per_sec;           // nominal sleeptimer frequency
+  int16_t ppm;
+  bool is_initialized;
+} uptime_clock_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 
+/*******************************************************************************
+ * Initializes the conversion on first use, once the sleeptimer runs.
+ * Has to be called in atomic section.
+ ******************************************************************************/
+static void uptime_clock_init(void);
+
+/*******************************************************************************
+ * Computes the tick period compensated by the crystal offset
+ ******************************************************************************/
+static uint64_t uptime_nsec_per_tick_q32(int16_t ppm);
+
+/*******************************************************************************
+ * Converts ticks elapsed since the conversion base to a duration, using
+ * multiplications only. The ticks must not exceed the rebase limit.
+ ******************************************************************************/
+static void uptime_ticks_to_timespec(uint32_t ticks, struct sid_timespec * time);
+
+/*******************************************************************************
+ * Converts a sleeptimer tick to uptime, moves the conversion base forward when
+ * the tick is too far from it. Has to be called in atomic section.
+ ******************************************************************************/
+static void uptime_tick_to_timespec(uint64_t tick, struct sid_timespec * time);
+
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -60,6 +103,8 @@
 //                                Static Variables
 // -----------------------------------------------------------------------------
 
+static uptime_clock_t uptime_clock;
+
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
@@ -78,13 +123,10 @@ sid_error_t sid_pal_uptime_now(struct sid_timespec * time)
 {
   SID_PAL_ASSERT(time != NULL);
 
-  uint64_t ticks = sl_sleeptimer_get_tick_count64();
-  uint32_t ticks_per_sec = sl_sleeptimer_get_timer_frequency();
-  uint64_t secs = ticks / ticks_per_sec;
-
-  uint64_t residual_ticks = ticks % ticks_per_sec;
-  time->tv_sec = secs;
-  time->tv_nsec = (residual_ticks * SID_TIME_NSEC_PER_SEC) / ticks_per_sec;
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  uptime_tick_to_timespec(sl_sleeptimer_get_tick_count64(), time);
+  CORE_EXIT_ATOMIC();
 
   return SID_ERROR_NONE;
 }
@@ -97,7 +139,27 @@ sid_error_t sid_pal_uptime_now(struct sid_timespec * time)
  ******************************************************************************/
 void sid_pal_uptime_set_xtal_ppm(int16_t ppm)
 {
-  (void)(ppm);
+  struct sid_timespec time;
+  uint64_t tick = 0;
+  bool is_changed = false;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (!uptime_clock.is_initialized || (uptime_clock.ppm != ppm)) {
+    // Time elapsed so far keeps the previous offset
+    tick = sl_sleeptimer_get_tick_count64();
+    uptime_tick_to_timespec(tick, &time);
+    uptime_clock.base_tick = tick;
+    uptime_clock.base_time = time;
+    uptime_clock.ppm = ppm;
+    uptime_clock.nsec_per_tick_q32 = uptime_nsec_per_tick_q32(ppm);
+    is_changed = true;
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (is_changed) {
+    sli_sid_pal_timer_xtal_ppm_changed();
+  }
 }
 
 /*******************************************************************************
@@ -107,9 +169,113 @@ void sid_pal_uptime_set_xtal_ppm(int16_t ppm)
  ******************************************************************************/
 int16_t sid_pal_uptime_get_xtal_ppm(void)
 {
-  return 0;
+  return uptime_clock.ppm;
+}
+
+uint64_t sli_sid_pal_uptime_to_tick(const struct sid_timespec * time)
+{
+  struct sid_timespec delta;
+  uint64_t ticks = 0;
+  int64_t correction = 0;
+  int64_t residual = 0;
+
+  SID_PAL_ASSERT(time != NULL);
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  uptime_clock_init();
+  if (sid_time_gt(time, &uptime_clock.base_time)) {
+    delta = *time;
+    sid_time_sub(&delta, &uptime_clock.base_time);
+
+    // Nominal ticks, rounded up not to expire early
+    ticks = ((uint64_t)delta.tv_sec * uptime_clock.ticks_per_sec)
+            + ((((uint64_t)delta.tv_nsec * uptime_clock.ticks_per_sec) + SID_TIME_NSEC_PER_SEC - 1U) / SID_TIME_NSEC_PER_SEC);
+
+    // Crystal offset, split not to overflow and rounded up as well
+    correction = (int64_t)(ticks / UPTIME_PPM_SCALE) * uptime_clock.ppm;
+    residual = (int64_t)(ticks % UPTIME_PPM_SCALE) * uptime_clock.ppm;
+    correction += residual / UPTIME_PPM_SCALE;
+    if (residual > ((residual / UPTIME_PPM_SCALE) * UPTIME_PPM_SCALE)) {
+      correction++;
+    }
+    ticks = (uint64_t)((int64_t)ticks + correction);
+  }
+  ticks += uptime_clock.base_tick;
+  CORE_EXIT_ATOMIC();
+
+  return ticks;
+}
+
+// Overridden by the timer module, projects without it have no timers to convert
+SL_WEAK void sli_sid_pal_timer_xtal_ppm_changed(void)
+{
 }
 
 // -----------------------------------------------------------------------------
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------
+
+static void uptime_clock_init(void)
+{
+  if (uptime_clock.is_initialized) {
+    return;
+  }
+
+  uptime_clock.ticks_per_sec = sl_sleeptimer_get_timer_frequency();
+  SID_PAL_ASSERT(uptime_clock.ticks_per_sec > 0);
+  uptime_clock.rebase_ticks = UPTIME_REBASE_MAX_SEC * uptime_clock.ticks_per_sec;
+  if (uptime_clock.rebase_ticks > UPTIME_REBASE_MAX_TICKS) {
+    uptime_clock.rebase_ticks = UPTIME_REBASE_MAX_TICKS;
+  }
+  uptime_clock.base_tick = 0;
+  uptime_clock.base_time = SID_TIME_ZERO;
+  uptime_clock.nsec_per_tick_q32 = uptime_nsec_per_tick_q32(uptime_clock.ppm);
+  uptime_clock.is_initialized = true;
+}
+
+static uint64_t uptime_nsec_per_tick_q32(int16_t ppm)
+{
+  // period = nominal period * 10^6 / (10^6 + ppm), a fast crystal has shorter ticks
+  uint64_t nominal = ((uint64_t)SID_TIME_NSEC_PER_SEC << 32) / uptime_clock.ticks_per_sec;
+  int64_t divisor = UPTIME_PPM_SCALE + ppm;
+  int64_t correction = ((int64_t)(nominal / (uint64_t)divisor) * ppm)
+                       + (((int64_t)(nominal % (uint64_t)divisor) * ppm) / divisor);
+
+  return (uint64_t)((int64_t)nominal - correction);
+}
+
+static void uptime_ticks_to_timespec(uint32_t ticks, struct sid_timespec * time)
+{
+  uint64_t nsec = ((uint64_t)ticks * (uptime_clock.nsec_per_tick_q32 >> 32))
+                  + (((uint64_t)ticks * (uptime_clock.nsec_per_tick_q32 & UINT32_MAX)) >> 32);
+  // Underestimated by at most a second, corrected below
+  uint32_t sec = (uint32_t)(((nsec >> 16) * UPTIME_NSEC_RECIPROCAL_Q48) >> 32);
+  uint64_t residual = nsec - ((uint64_t)sec * SID_TIME_NSEC_PER_SEC);
+
+  while (residual >= SID_TIME_NSEC_PER_SEC) {
+    residual -= SID_TIME_NSEC_PER_SEC;
+    sec++;
+  }
+
+  time->tv_sec = sec;
+  time->tv_nsec = (uint32_t)residual;
+}
+
+static void uptime_tick_to_timespec(uint64_t tick, struct sid_timespec * time)
+{
+  struct sid_timespec elapsed;
+
+  uptime_clock_init();
+
+  // Rarely more than one step, unless no time was read for a long while
+  while ((tick - uptime_clock.base_tick) >= uptime_clock.rebase_ticks) {
+    uptime_ticks_to_timespec((uint32_t)uptime_clock.rebase_ticks, &elapsed);
+    sid_time_add(&uptime_clock.base_time, &elapsed);
+    uptime_clock.base_tick += uptime_clock.rebase_ticks;
+  }
+
+  uptime_ticks_to_timespec((uint32_t)(tick - uptime_clock.base_tick), &elapsed);
+  *time = uptime_clock.base_time;
+  sid_time_add(time, &elapsed);
+}
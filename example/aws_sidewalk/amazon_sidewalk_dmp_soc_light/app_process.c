@@ -42,6 +42,7 @@
 #include "sl_bt_api.h"
 #include "sl_sidewalk_common_config.h"
 #include "sl_malloc.h"
+#include "storage_kv.h"
 #include "app_button_press.h"
 #include "sl_sidewalk_nvm3_handler.h"
 
@@ -715,6 +716,8 @@ static void on_sidewalk_factory_reset(void *context)
   UNUSED(context);
   app_log_info("app: factory reset notif rcvd");
   // This is the callback function of the factory reset and as the last step a reset is applied.
+  // Changes held by the KV write-back cache would be lost otherwise
+  (void)sli_sid_storage_kv_flush();
   NVIC_SystemReset();
 }
 
@@ -732,6 +735,8 @@ static void dev_reset_timer_cb(TimerHandle_t tmr_hdl)
     }
   } else if (g_app_ctx.app_msg.rst_dev_ctx.param_send.reset_type == SL_SID_APP_MSG_DEV_MGMT_VAL_RST_SOFT) {
     app_log_info("app: resetting device");
+    // Changes held by the KV write-back cache would be lost otherwise
+    (void)sli_sid_storage_kv_flush();
     NVIC_SystemReset();
   } else {
     app_log_error("app: unexpected reset type: %d", g_app_ctx.app_msg.rst_dev_ctx.param_send.reset_type);
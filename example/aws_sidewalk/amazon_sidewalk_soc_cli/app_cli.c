@@ -40,6 +40,9 @@
 #include "app_init.h"
 #include "app_cli_settings.h"
 #include "app_log.h"
+#include "timer_stats.h"
+#include "log_deferred.h"
+#include "crypto_ecc_pool.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -166,6 +169,92 @@ void cli_sid_ble_connect(sl_cli_command_arg_t *arguments)
   sl_app_trigger_ble_connection_request();
 }
 
+/******************************************************************************
+ * CLI - sid timers [reset]
+ * Print the sid_pal timer wakeup statistics per priority class
+ *****************************************************************************/
+void cli_sid_timer_stats(sl_cli_command_arg_t *arguments)
+{
+  sli_sid_pal_timer_stats_t stats;
+
+  if (sl_cli_get_argument_count(arguments) == 1) {
+    const char *option = sl_cli_get_command_string(arguments, 2);
+    if (strcmp(option, "reset") == 0) {
+      sli_sid_pal_timer_reset_stats();
+      app_log_info("app: timer stats reset");
+    } else {
+      app_log_error("app: unknown argument: %s", option);
+    }
+    return;
+  }
+
+  sli_sid_pal_timer_get_stats(&stats);
+  app_log_info("app: timer wakeups: %lu", (unsigned long)stats.wakeups);
+  app_log_info("app: precise: armed %lu, arms %lu, fires %lu, coalesced %lu, lateness avg %lu us max %lu us",
+               (unsigned long)stats.precise.armed,
+               (unsigned long)stats.precise.arms,
+               (unsigned long)stats.precise.fires,
+               (unsigned long)stats.precise.coalesced_fires,
+               (unsigned long)stats.precise.avg_lateness_us,
+               (unsigned long)stats.precise.max_lateness_us);
+  app_log_info("app: lowpower: armed %lu, arms %lu, fires %lu, coalesced %lu, lateness avg %lu us max %lu us",
+               (unsigned long)stats.lowpower.armed,
+               (unsigned long)stats.lowpower.arms,
+               (unsigned long)stats.lowpower.fires,
+               (unsigned long)stats.lowpower.coalesced_fires,
+               (unsigned long)stats.lowpower.avg_lateness_us,
+               (unsigned long)stats.lowpower.max_lateness_us);
+}
+
+/******************************************************************************
+ * CLI - sid crashlog [clear]
+ * Print the log records of the previous run, decoded on the host by
+ * tools/scripts/public/sid_log_decoder
+ *****************************************************************************/
+void cli_sid_crash_log(sl_cli_command_arg_t *arguments)
+{
+  if (sl_cli_get_argument_count(arguments) == 1) {
+    const char *option = sl_cli_get_command_string(arguments, 2);
+    if (strcmp(option, "clear") == 0) {
+      sli_sid_pal_log_crash_clear();
+      app_log_info("app: crash log cleared");
+    } else {
+      app_log_error("app: unknown argument: %s", option);
+    }
+    return;
+  }
+
+  sli_sid_pal_log_crash_print();
+}
+
+/******************************************************************************
+ * CLI - sid eccpool [reset]
+ * Print the pre-generated ECDH key pool statistics
+ *****************************************************************************/
+void cli_sid_ecc_pool_stats(sl_cli_command_arg_t *arguments)
+{
+  sli_sid_pal_crypto_ecc_pool_stats_t stats;
+
+  if (sl_cli_get_argument_count(arguments) == 1) {
+    const char *option = sl_cli_get_command_string(arguments, 2);
+    if (strcmp(option, "reset") == 0) {
+      sli_sid_pal_crypto_reset_ecc_pool_stats();
+      app_log_info("app: ecc pool stats reset");
+    } else {
+      app_log_error("app: unknown argument: %s", option);
+    }
+    return;
+  }
+
+  sli_sid_pal_crypto_get_ecc_pool_stats(&stats);
+  app_log_info("app: ecc pool: hits %lu, misses %lu, refills %lu, available p256 %u x25519 %u",
+               (unsigned long)stats.hits,
+               (unsigned long)stats.misses,
+               (unsigned long)stats.refills,
+               stats.p256_available,
+               stats.x25519_available);
+}
+
 /******************************************************************************
  * Get - sidewalk time
  *
@@ -127,6 +127,30 @@ void cli_sid_deinit(sl_cli_command_arg_t *arguments);
  ******************************************************************************/
 void cli_sid_ble_connect(sl_cli_command_arg_t *arguments);
 
+/*******************************************************************************
+ * CLI - timer statistics
+ *
+ * @param[in] arguments CLI arguments
+ * @returns None
+ ******************************************************************************/
+void cli_sid_timer_stats(sl_cli_command_arg_t *arguments);
+
+/*******************************************************************************
+ * CLI - crash log
+ *
+ * @param[in] arguments CLI arguments
+ * @returns None
+ ******************************************************************************/
+void cli_sid_crash_log(sl_cli_command_arg_t *arguments);
+
+/*******************************************************************************
+ * CLI - ECDH key pool statistics
+ *
+ * @param[in] arguments CLI arguments
+ * @returns None
+ ******************************************************************************/
+void cli_sid_ecc_pool_stats(sl_cli_command_arg_t *arguments);
+
 /*******************************************************************************
  * Function to get sidewalk time
  *
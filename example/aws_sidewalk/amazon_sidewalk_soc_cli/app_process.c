@@ -45,6 +45,7 @@
 
 #include "sl_sidewalk_common_config.h"
 #include "sl_malloc.h"
+#include "storage_kv.h"
 
 #if (defined(SL_FSK_SUPPORTED) || defined(SL_CSS_SUPPORTED))
 #include "app_subghz_config.h"
@@ -532,6 +533,8 @@ static void on_sidewalk_factory_reset(void *context)
   UNUSED(context);
   app_log_info("app: factory reset notif rcvd\n");
   // This is the callback function of the factory reset and as the last step a reset is applied.
+  // Changes held by the KV write-back cache would be lost otherwise
+  (void)sli_sid_storage_kv_flush();
   NVIC_SystemReset();
 }
 
@@ -764,6 +767,8 @@ static void reset_sidewalk(app_context_t *context)
     if (ret != SID_ERROR_NONE) {
       app_log_error("app: factory reset notif failed: %d\n", ret);
       vTaskDelay(pdMS_TO_TICKS(200));
+      // Changes held by the KV write-back cache would be lost otherwise
+      (void)sli_sid_storage_kv_flush();
       NVIC_SystemReset();
     } else {
       app_log_info("app: wait to proceed with factory reset\n");
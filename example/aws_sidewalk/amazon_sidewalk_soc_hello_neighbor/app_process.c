@@ -41,6 +41,7 @@
 #include "sid_api.h"
 #include "sl_sidewalk_common_config.h"
 #include "sl_malloc.h"
+#include "storage_kv.h"
 #include "app_button_press.h"
 
 #if defined(SL_BOARD_SUPPORT)
@@ -811,6 +812,8 @@ static void on_sidewalk_factory_reset(void *context)
   UNUSED(context);
   app_log_info("app: factory reset notif rcvd");
   // This is the callback function of the factory reset and as the last step a reset is applied.
+  // Changes held by the KV write-back cache would be lost otherwise
+  (void)sli_sid_storage_kv_flush();
   NVIC_SystemReset();
 }
 
@@ -916,6 +919,8 @@ static void factory_reset(app_context_t *context)
   if (ret != SID_ERROR_NONE) {
     app_log_error("app: factory reset notif failed");
 
+    // Changes held by the KV write-back cache would be lost otherwise
+    (void)sli_sid_storage_kv_flush();
     NVIC_SystemReset();
   } else {
     app_log_info("app: wait to proceed with factory reset");
@@ -0,0 +1,692 @@
+/***************************************************************************//**
+ * @file
+ * @brief crypto_bench.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include "crypto_bench.h"
+#include "crypto_stream.h"
+#include <sid_pal_crypto_ifc.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES        1
+#else
+#define BENCH_HAS_CYCLES        0
+#endif
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define BENCH_MAX_SIZE          (4096)
+#define BENCH_DEFAULT_SIZE      (64)
+#define BENCH_DEFAULT_SECONDS   (1.0)
+#define BENCH_CHUNKS            (3)
+#define BENCH_TAG_SIZE          (16)
+#define BENCH_CCM_NONCE_SIZE    (13)
+#define BENCH_GCM_NONCE_SIZE    (12)
+
+// Given to the PAL as well by CMakeLists.txt
+#ifndef SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE
+#define SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE 0
+#endif
+
+typedef struct {
+  const char *name;
+  bool per_byte;          // processes the payload, otherwise a fixed size input
+  sid_error_t (*run)(void);
+} bench_case_t;
+
+typedef struct {
+  uint8_t prk[32];
+  uint8_t puk[64];
+  size_t puk_size;
+} bench_key_pair_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static size_t bench_size = BENCH_DEFAULT_SIZE;
+static uint8_t bench_in[BENCH_MAX_SIZE];
+static uint8_t bench_out[BENCH_MAX_SIZE];
+static uint8_t bench_key[16];
+static uint8_t bench_iv[16];
+static uint8_t bench_aad[16];
+static uint8_t bench_tag[BENCH_TAG_SIZE];
+static sli_sid_pal_crypto_chunk_t bench_chunks[BENCH_CHUNKS];
+
+// Valid ciphertexts and signatures, for the decrypt and verify cases
+static uint8_t bench_gcm_cipher[BENCH_MAX_SIZE];
+static uint8_t bench_gcm_tag[BENCH_TAG_SIZE];
+static uint8_t bench_ccm_cipher[BENCH_MAX_SIZE];
+static uint8_t bench_ccm_tag[BENCH_TAG_SIZE];
+static uint8_t bench_ecdsa_sig[64];
+
+static bench_key_pair_t bench_ecdsa_key;
+static bench_key_pair_t bench_p256_key;
+static bench_key_pair_t bench_x25519_key;
+#if CRYPTO_BENCH_ED25519
+static uint8_t bench_ed25519_sig[64];
+static bench_key_pair_t bench_ed25519_key;
+#endif
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static uint64_t bench_now_ns(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+// TSC ticks, at the nominal clock of the CPU whatever the current one is
+static uint64_t bench_cycles(void)
+{
+#if BENCH_HAS_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static sid_error_t bench_rand(void)
+{
+  return sid_pal_crypto_rand(bench_out, bench_size);
+}
+
+static sid_error_t bench_hash(sid_pal_hash_algo_t algo)
+{
+  sid_pal_hash_params_t params = {
+    .algo = algo,
+    .data = bench_in,
+    .data_size = bench_size,
+    .digest = bench_out,
+    .digest_size = 64,
+  };
+
+  return sid_pal_crypto_hash(&params);
+}
+
+static sid_error_t bench_sha256(void)
+{
+  return bench_hash(SID_PAL_HASH_SHA256);
+}
+
+static sid_error_t bench_sha512(void)
+{
+  return bench_hash(SID_PAL_HASH_SHA512);
+}
+
+static sid_error_t bench_sha256_stream(void)
+{
+  sli_sid_pal_crypto_stream_t stream = { 0 };
+  sid_error_t ret = sli_sid_pal_crypto_hash_start(&stream, SID_PAL_HASH_SHA256);
+
+  for (size_t i = 0; i < BENCH_CHUNKS && ret == SID_ERROR_NONE; i++) {
+    ret = sli_sid_pal_crypto_stream_update(&stream, bench_chunks[i].data, bench_chunks[i].size,
+                                           NULL, 0, NULL);
+  }
+  if (ret == SID_ERROR_NONE) {
+    ret = sli_sid_pal_crypto_stream_finish(&stream, NULL, 0, NULL, bench_out, 32);
+  }
+
+  return ret;
+}
+
+static sid_error_t bench_hmac(sid_pal_hash_algo_t algo)
+{
+  sid_pal_hmac_params_t params = {
+    .algo = algo,
+    .key = bench_key,
+    .key_size = sizeof(bench_key),
+    .data = bench_in,
+    .data_size = bench_size,
+    .digest = bench_out,
+    .digest_size = 64,
+  };
+
+  return sid_pal_crypto_hmac(&params);
+}
+
+static sid_error_t bench_hmac_sha256(void)
+{
+  return bench_hmac(SID_PAL_HASH_SHA256);
+}
+
+static sid_error_t bench_hmac_sha512(void)
+{
+  return bench_hmac(SID_PAL_HASH_SHA512);
+}
+
+static sid_pal_aes_params_t bench_aes_params(sid_pal_aes_algo_t algo, sid_pal_aes_mode_t mode)
+{
+  sid_pal_aes_params_t params = {
+    .algo = algo,
+    .mode = mode,
+    .key = bench_key,
+    .key_size = sizeof(bench_key) * 8,
+    .iv = bench_iv,
+    .iv_size = sizeof(bench_iv),
+    .in = bench_in,
+    .in_size = bench_size,
+    .out = bench_out,
+    .out_size = sizeof(bench_out),
+  };
+
+  return params;
+}
+
+#if CRYPTO_BENCH_CMAC
+static sid_error_t bench_cmac(void)
+{
+  sid_pal_aes_params_t params = bench_aes_params(SID_PAL_AES_CMAC_128, SID_PAL_CRYPTO_MAC_CALCULATE);
+
+  return sid_pal_crypto_aes_crypt(&params);
+}
+
+static sid_error_t bench_cmac_sg(void)
+{
+  sid_pal_aes_params_t params = bench_aes_params(SID_PAL_AES_CMAC_128, SID_PAL_CRYPTO_MAC_CALCULATE);
+
+  return sli_sid_pal_crypto_aes_crypt_sg(&params, bench_chunks, BENCH_CHUNKS);
+}
+#endif
+
+static sid_error_t bench_ctr_encrypt(void)
+{
+  sid_pal_aes_params_t params = bench_aes_params(SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_ENCRYPT);
+
+  return sid_pal_crypto_aes_crypt(&params);
+}
+
+static sid_error_t bench_ctr_decrypt(void)
+{
+  sid_pal_aes_params_t params = bench_aes_params(SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_DECRYPT);
+
+  return sid_pal_crypto_aes_crypt(&params);
+}
+
+static sid_error_t bench_ctr_encrypt_sg(void)
+{
+  sid_pal_aes_params_t params = bench_aes_params(SID_PAL_AES_CTR_128, SID_PAL_CRYPTO_ENCRYPT);
+
+  return sli_sid_pal_crypto_aes_crypt_sg(&params, bench_chunks, BENCH_CHUNKS);
+}
+
+static sid_pal_aead_params_t bench_aead_params(sid_pal_aead_algo_t algo, sid_pal_aes_mode_t mode)
+{
+  bool gcm = (algo == SID_PAL_AEAD_GCM_128);
+  bool encrypt = (mode == SID_PAL_CRYPTO_ENCRYPT);
+  sid_pal_aead_params_t params = {
+    .algo = algo,
+    .mode = mode,
+    .key = bench_key,
+    .key_size = sizeof(bench_key) * 8,
+    .iv = bench_iv,
+    .iv_size = gcm ? BENCH_GCM_NONCE_SIZE : BENCH_CCM_NONCE_SIZE,
+    .aad = bench_aad,
+    .aad_size = sizeof(bench_aad),
+    .in = encrypt ? bench_in : (gcm ? bench_gcm_cipher : bench_ccm_cipher),
+    .in_size = bench_size,
+    .out = bench_out,
+    .out_size = bench_size,
+    .mac = encrypt ? bench_tag : (gcm ? bench_gcm_tag : bench_ccm_tag),
+    .mac_size = BENCH_TAG_SIZE,
+  };
+
+  return params;
+}
+
+static sid_error_t bench_gcm_encrypt(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_GCM_128, SID_PAL_CRYPTO_ENCRYPT);
+
+  return sid_pal_crypto_aead_crypt(&params);
+}
+
+static sid_error_t bench_gcm_decrypt(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_GCM_128, SID_PAL_CRYPTO_DECRYPT);
+
+  return sid_pal_crypto_aead_crypt(&params);
+}
+
+static sid_error_t bench_gcm_encrypt_sg(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_GCM_128, SID_PAL_CRYPTO_ENCRYPT);
+  sli_sid_pal_crypto_chunk_t aad = { bench_aad, sizeof(bench_aad) };
+
+  return sli_sid_pal_crypto_aead_crypt_sg(&params, &aad, 1, bench_chunks, BENCH_CHUNKS);
+}
+
+static sid_error_t bench_ccm_encrypt(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_CCM_128, SID_PAL_CRYPTO_ENCRYPT);
+
+  return sid_pal_crypto_aead_crypt(&params);
+}
+
+static sid_error_t bench_ccm_decrypt(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_CCM_128, SID_PAL_CRYPTO_DECRYPT);
+
+  return sid_pal_crypto_aead_crypt(&params);
+}
+
+static sid_error_t bench_ccm_encrypt_sg(void)
+{
+  sid_pal_aead_params_t params = bench_aead_params(SID_PAL_AEAD_CCM_128, SID_PAL_CRYPTO_ENCRYPT);
+  sli_sid_pal_crypto_chunk_t aad = { bench_aad, sizeof(bench_aad) };
+
+  return sli_sid_pal_crypto_aead_crypt_sg(&params, &aad, 1, bench_chunks, BENCH_CHUNKS);
+}
+
+static sid_error_t bench_dsa(sid_pal_ecc_algo_t algo, sid_pal_dsa_mode_t mode,
+                             const bench_key_pair_t *key, uint8_t *signature)
+{
+  bool sign = (mode == SID_PAL_CRYPTO_SIGN);
+  sid_pal_dsa_params_t params = {
+    .algo = algo,
+    .mode = mode,
+    .key = sign ? key->prk : key->puk,
+    .key_size = sign ? sizeof(key->prk) : key->puk_size,
+    .in = bench_in,
+    .in_size = bench_size,
+    .signature = signature,
+    .sig_size = 64,
+  };
+
+  return sid_pal_crypto_ecc_dsa(&params);
+}
+
+static sid_error_t bench_ecdsa_sign(void)
+{
+  return bench_dsa(SID_PAL_ECDSA_SECP256R1, SID_PAL_CRYPTO_SIGN, &bench_ecdsa_key, bench_out);
+}
+
+static sid_error_t bench_ecdsa_verify(void)
+{
+  return bench_dsa(SID_PAL_ECDSA_SECP256R1, SID_PAL_CRYPTO_VERIFY, &bench_ecdsa_key, bench_ecdsa_sig);
+}
+
+#if CRYPTO_BENCH_ED25519
+static sid_error_t bench_ed25519_sign(void)
+{
+  return bench_dsa(SID_PAL_EDDSA_ED25519, SID_PAL_CRYPTO_SIGN, &bench_ed25519_key, bench_out);
+}
+
+static sid_error_t bench_ed25519_verify(void)
+{
+  return bench_dsa(SID_PAL_EDDSA_ED25519, SID_PAL_CRYPTO_VERIFY, &bench_ed25519_key, bench_ed25519_sig);
+}
+#endif
+
+// Agreement of the key pair with its own public key, which costs the same
+static sid_error_t bench_ecdh(sid_pal_ecc_algo_t algo, const bench_key_pair_t *key)
+{
+  sid_pal_ecdh_params_t params = {
+    .algo = algo,
+    .prk = key->prk,
+    .prk_size = sizeof(key->prk),
+    .puk = key->puk,
+    .puk_size = key->puk_size,
+    .shared_secret = bench_out,
+    .shared_secret_sz = 32,
+  };
+
+  return sid_pal_crypto_ecc_ecdh(&params);
+}
+
+static sid_error_t bench_ecdh_x25519(void)
+{
+  return bench_ecdh(SID_PAL_ECDH_CURVE25519, &bench_x25519_key);
+}
+
+static sid_error_t bench_ecdh_p256(void)
+{
+  return bench_ecdh(SID_PAL_ECDH_SECP256R1, &bench_p256_key);
+}
+
+static sid_error_t bench_key_gen(sid_pal_ecc_algo_t algo, bench_key_pair_t *key)
+{
+  key->puk_size = (algo == SID_PAL_ECDH_SECP256R1 || algo == SID_PAL_ECDSA_SECP256R1) ? 64 : 32;
+
+  sid_pal_ecc_key_gen_params_t params = {
+    .algo = algo,
+    .prk = key->prk,
+    .prk_size = sizeof(key->prk),
+    .puk = key->puk,
+    .puk_size = key->puk_size,
+  };
+
+  return sid_pal_crypto_ecc_key_gen(&params);
+}
+
+static sid_error_t bench_key_gen_x25519(void)
+{
+  bench_key_pair_t key;
+
+  return bench_key_gen(SID_PAL_ECDH_CURVE25519, &key);
+}
+
+static sid_error_t bench_key_gen_p256_ecdh(void)
+{
+  bench_key_pair_t key;
+
+  return bench_key_gen(SID_PAL_ECDH_SECP256R1, &key);
+}
+
+static sid_error_t bench_key_gen_p256_ecdsa(void)
+{
+  bench_key_pair_t key;
+
+  return bench_key_gen(SID_PAL_ECDSA_SECP256R1, &key);
+}
+
+#if CRYPTO_BENCH_ED25519
+static sid_error_t bench_key_gen_ed25519(void)
+{
+  bench_key_pair_t key;
+
+  return bench_key_gen(SID_PAL_EDDSA_ED25519, &key);
+}
+#endif
+
+// Also drops the key cache, so it runs last
+static sid_error_t bench_init_deinit(void)
+{
+  sid_error_t ret = sid_pal_crypto_deinit();
+
+  if (ret == SID_ERROR_NONE) {
+    ret = sid_pal_crypto_init();
+  }
+
+  return ret;
+}
+
+static const bench_case_t bench_cases[] = {
+  { "rand", true, bench_rand },
+  { "hash SHA-256", true, bench_sha256 },
+  { "hash SHA-512", true, bench_sha512 },
+  { "hash SHA-256 stream", true, bench_sha256_stream },
+  { "hmac SHA-256", true, bench_hmac_sha256 },
+  { "hmac SHA-512", true, bench_hmac_sha512 },
+#if CRYPTO_BENCH_CMAC
+  { "aes CMAC", true, bench_cmac },
+  { "aes CMAC scatter-gather", true, bench_cmac_sg },
+#endif
+  { "aes CTR encrypt", true, bench_ctr_encrypt },
+  { "aes CTR decrypt", true, bench_ctr_decrypt },
+  { "aes CTR encrypt scatter-gather", true, bench_ctr_encrypt_sg },
+  { "aead GCM encrypt", true, bench_gcm_encrypt },
+  { "aead GCM decrypt", true, bench_gcm_decrypt },
+  { "aead GCM encrypt scatter-gather", true, bench_gcm_encrypt_sg },
+  { "aead CCM encrypt", true, bench_ccm_encrypt },
+  { "aead CCM decrypt", true, bench_ccm_decrypt },
+  { "aead CCM encrypt scatter-gather", true, bench_ccm_encrypt_sg },
+  { "ecc_dsa ECDSA P-256 sign", false, bench_ecdsa_sign },
+  { "ecc_dsa ECDSA P-256 verify", false, bench_ecdsa_verify },
+#if CRYPTO_BENCH_ED25519
+  { "ecc_dsa Ed25519 sign", false, bench_ed25519_sign },
+  { "ecc_dsa Ed25519 verify", false, bench_ed25519_verify },
+#endif
+  { "ecc_ecdh X25519", false, bench_ecdh_x25519 },
+  { "ecc_ecdh P-256", false, bench_ecdh_p256 },
+  { "ecc_key_gen X25519", false, bench_key_gen_x25519 },
+  { "ecc_key_gen P-256 ECDH", false, bench_key_gen_p256_ecdh },
+  { "ecc_key_gen P-256 ECDSA", false, bench_key_gen_p256_ecdsa },
+#if CRYPTO_BENCH_ED25519
+  { "ecc_key_gen Ed25519", false, bench_key_gen_ed25519 },
+#endif
+  { "init and deinit", false, bench_init_deinit },
+};
+
+// Keys, ciphertexts and signatures the cases need, made with the PAL itself
+static sid_error_t bench_setup(void)
+{
+  size_t first = (bench_size > 1) ? 1 : bench_size;
+  size_t second = (bench_size - first) / 2;
+  sid_error_t ret;
+
+  for (size_t i = 0; i < sizeof(bench_in); i++) {
+    bench_in[i] = (uint8_t)i;
+  }
+  memset(bench_key, 0x2b, sizeof(bench_key));
+  memset(bench_iv, 0xf0, sizeof(bench_iv));
+  memset(bench_aad, 0xa5, sizeof(bench_aad));
+
+  bench_chunks[0] = (sli_sid_pal_crypto_chunk_t){ bench_in, first };
+  bench_chunks[1] = (sli_sid_pal_crypto_chunk_t){ bench_in + first, second };
+  bench_chunks[2] = (sli_sid_pal_crypto_chunk_t){ bench_in + first + second, bench_size - first - second };
+
+  sid_pal_aead_params_t gcm = bench_aead_params(SID_PAL_AEAD_GCM_128, SID_PAL_CRYPTO_ENCRYPT);
+  gcm.out = bench_gcm_cipher;
+  gcm.mac = bench_gcm_tag;
+  ret = sid_pal_crypto_aead_crypt(&gcm);
+  if (ret != SID_ERROR_NONE) {
+    return ret;
+  }
+
+  sid_pal_aead_params_t ccm = bench_aead_params(SID_PAL_AEAD_CCM_128, SID_PAL_CRYPTO_ENCRYPT);
+  ccm.out = bench_ccm_cipher;
+  ccm.mac = bench_ccm_tag;
+  ret = sid_pal_crypto_aead_crypt(&ccm);
+  if (ret != SID_ERROR_NONE) {
+    return ret;
+  }
+
+  ret = bench_key_gen(SID_PAL_ECDSA_SECP256R1, &bench_ecdsa_key);
+  if (ret == SID_ERROR_NONE) {
+    ret = bench_dsa(SID_PAL_ECDSA_SECP256R1, SID_PAL_CRYPTO_SIGN, &bench_ecdsa_key, bench_ecdsa_sig);
+  }
+#if CRYPTO_BENCH_ED25519
+  if (ret == SID_ERROR_NONE) {
+    ret = bench_key_gen(SID_PAL_EDDSA_ED25519, &bench_ed25519_key);
+  }
+  if (ret == SID_ERROR_NONE) {
+    ret = bench_dsa(SID_PAL_EDDSA_ED25519, SID_PAL_CRYPTO_SIGN, &bench_ed25519_key, bench_ed25519_sig);
+  }
+#endif
+  if (ret == SID_ERROR_NONE) {
+    ret = bench_key_gen(SID_PAL_ECDH_SECP256R1, &bench_p256_key);
+  }
+  if (ret == SID_ERROR_NONE) {
+    ret = bench_key_gen(SID_PAL_ECDH_CURVE25519, &bench_x25519_key);
+  }
+
+  return ret;
+}
+
+// Runs the case in growing batches until the time is up, so that reading the
+// clock does not weigh on the short operations
+static bool bench_run(const bench_case_t *bench, double seconds)
+{
+  uint64_t duration_ns = (uint64_t)(seconds * 1e9);
+  uint64_t batch = 1;
+  uint64_t ops = 0;
+  uint64_t elapsed_ns;
+  uint64_t start_ns;
+  uint64_t start_cycles;
+  uint64_t cycles;
+  sid_error_t ret;
+
+  // Warm-up, which also spots a failing case before it is timed
+  ret = bench->run();
+  if (ret != SID_ERROR_NONE) {
+    printf("  %-36s FAIL, error %d\n", bench->name, (int)ret);
+    return false;
+  }
+
+  start_ns = bench_now_ns();
+  start_cycles = bench_cycles();
+  for (;;) {
+    for (uint64_t i = 0; i < batch; i++) {
+      ret = bench->run();
+      if (ret != SID_ERROR_NONE) {
+        printf("  %-36s FAIL, error %d after %llu operations\n", bench->name, (int)ret,
+               (unsigned long long)(ops + i));
+        return false;
+      }
+    }
+    ops += batch;
+    elapsed_ns = bench_now_ns() - start_ns;
+    if (elapsed_ns >= duration_ns) {
+      break;
+    }
+    if (elapsed_ns < duration_ns / 16) {
+      batch *= 2;
+    }
+  }
+  cycles = bench_cycles() - start_cycles;
+
+  double ops_per_s = (double)ops * 1e9 / (double)elapsed_ns;
+  double cycles_per_op = (double)cycles / (double)ops;
+  printf("  %-36s %12.0f", bench->name, ops_per_s);
+  if (BENCH_HAS_CYCLES) {
+    printf(" %12.0f", cycles_per_op);
+    if (bench->per_byte) {
+      printf(" %12.2f", cycles_per_op / (double)bench_size);
+    } else {
+      printf(" %12s", "-");
+    }
+  }
+  printf("\n");
+
+  return true;
+}
+
+static int bench_all(double seconds)
+{
+  int failures = 0;
+  sid_error_t ret = bench_setup();
+
+  if (ret != SID_ERROR_NONE) {
+    printf("benchmark setup failed (%d)\n", (int)ret);
+    return 1;
+  }
+
+  printf("Benchmark, %zu byte payload, %g s per case, key cache of %d entries:\n",
+         bench_size, seconds, SL_SIDEWALK_PAL_CRYPTO_KEY_CACHE_SIZE);
+  printf("  %-36s %12s", "operation", "ops/s");
+  if (BENCH_HAS_CYCLES) {
+    printf(" %12s %12s", "cycles/op", "cycles/byte");
+  }
+  printf("\n");
+
+  for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+    if (!bench_run(&bench_cases[i], seconds)) {
+      failures++;
+    }
+  }
+#if !CRYPTO_BENCH_CMAC
+  printf("  %-36s not supported by the PSA library\n", "aes CMAC");
+#endif
+#if !CRYPTO_BENCH_ED25519
+  printf("  %-36s not supported by the PSA library\n", "Ed25519");
+#endif
+  printf("%d failure(s)\n", failures);
+
+  return failures;
+}
+
+static void usage(const char *name)
+{
+  printf("Usage: %s [--kat-only | --bench-only] [--time SECONDS] [--size BYTES]\n"
+         "  --kat-only     run the known-answer tests only\n"
+         "  --bench-only   run the benchmark only\n"
+         "  --time         time spent on each benchmark case, default %g\n"
+         "  --size         payload of the hash, MAC and cipher cases, 1 to %d, default %d\n",
+         name, BENCH_DEFAULT_SECONDS, BENCH_MAX_SIZE, BENCH_DEFAULT_SIZE);
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  bool run_kat = true;
+  bool run_bench = true;
+  double seconds = BENCH_DEFAULT_SECONDS;
+  int failures = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--kat-only") == 0) {
+      run_bench = false;
+    } else if (strcmp(argv[i], "--bench-only") == 0) {
+      run_kat = false;
+    } else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+      seconds = strtod(argv[++i], NULL);
+      if (seconds <= 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+      unsigned long size = strtoul(argv[++i], NULL, 0);
+      if (size == 0 || size > BENCH_MAX_SIZE) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      bench_size = size;
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (sid_pal_crypto_init() != SID_ERROR_NONE) {
+    printf("crypto PAL init failed\n");
+    return EXIT_FAILURE;
+  }
+
+  if (run_kat) {
+    failures += crypto_kat_run();
+  }
+  if (run_bench) {
+    failures += bench_all(seconds);
+  }
+
+  (void)sid_pal_crypto_deinit();
+
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file
+ * @brief crypto_bench.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef CRYPTO_BENCH_H
+#define CRYPTO_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+
+#include "psa/crypto.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+
+// mbedTLS has no PureEdDSA, the Ed25519 cases are reported as not supported
+#if defined(PSA_WANT_ALG_PURE_EDDSA) && defined(PSA_WANT_ECC_TWISTED_EDWARDS_255)
+#define CRYPTO_BENCH_ED25519    1
+#else
+#define CRYPTO_BENCH_ED25519    0
+#endif
+
+#if defined(PSA_WANT_ALG_CMAC)
+#define CRYPTO_BENCH_CMAC       1
+#else
+#define CRYPTO_BENCH_CMAC       0
+#endif
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/*******************************************************************************
+ * Checks every sid_pal_crypto_* entry point and the stream API against known
+ * answers, the PAL has to be initialized. Returns the number of failures.
+ ******************************************************************************/
+int crypto_kat_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_BENCH_H */
@@ -0,0 +1,673 @@
+/***************************************************************************//**
+ * @file
+ * @brief crypto_kat.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ * Your use of this software is governed by the terms of
+ * Silicon Labs Master Software License Agreement (MSLA)available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.
+ * This software contains Third Party Software licensed by Silicon Labs from
+ * Amazon.com Services LLC and its affiliates and is governed by the sections
+ * of the MSLA applicable to Third Party Software and the additional terms set
+ * forth in amazon_sidewalk_license.txt.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *  claim that you wrote the original software. If you use this software
+ *  in a product, an acknowledgment in the product documentation would be
+ *  appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *  misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include "crypto_bench.h"
+#include "crypto_stream.h"
+#include <sid_pal_crypto_ifc.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define KAT_MAX_SIZE          (128)
+#define KAT_CHUNKS            (3)
+
+typedef struct {
+  uint8_t data[KAT_MAX_SIZE];
+  size_t size;
+} kat_buf_t;
+
+typedef struct {
+  const char *name;
+  sid_pal_aes_algo_t algo;
+  const char *key;
+  const char *iv;
+  const char *in;
+  const char *out;
+} kat_aes_vector_t;
+
+typedef struct {
+  const char *name;
+  sid_pal_aead_algo_t algo;
+  const char *key;
+  const char *iv;
+  const char *aad;
+  const char *plain;
+  const char *cipher;
+  const char *tag;
+} kat_aead_vector_t;
+
+typedef struct {
+  const char *name;
+  sid_pal_ecc_algo_t algo;
+  const char *prk_a;
+  const char *puk_a;
+  const char *prk_b;
+  const char *puk_b;
+  const char *shared;
+} kat_ecdh_vector_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static int kat_failures;
+
+// FIPS 180-2 appendix B and C
+static const struct {
+  const char *name;
+  sid_pal_hash_algo_t algo;
+  const char *msg;
+  const char *digest;
+} kat_hash_vectors[] = {
+  { "SHA-256 abc", SID_PAL_HASH_SHA256, "abc",
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+  { "SHA-256 two blocks", SID_PAL_HASH_SHA256,
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+  { "SHA-512 abc", SID_PAL_HASH_SHA512, "abc",
+    "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+    "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f" },
+};
+
+// RFC 4231 test case 2
+static const struct {
+  const char *name;
+  sid_pal_hash_algo_t algo;
+  const char *digest;
+} kat_hmac_vectors[] = {
+  { "HMAC-SHA-256", SID_PAL_HASH_SHA256,
+    "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" },
+  { "HMAC-SHA-512", SID_PAL_HASH_SHA512,
+    "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+    "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737" },
+};
+
+#define KAT_AES_KEY   "2b7e151628aed2a6abf7158809cf4f3c"
+#define KAT_AES_PLAIN "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51" \
+                      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"
+
+// RFC 4493 examples 2 to 4 and SP 800-38A F.5.1
+static const kat_aes_vector_t kat_aes_vectors[] = {
+#if CRYPTO_BENCH_CMAC
+  { "AES-CMAC 16 bytes", SID_PAL_AES_CMAC_128, KAT_AES_KEY, NULL,
+    "6bc1bee22e409f96e93d7e117393172a",
+    "070a16b46b4d4144f79bdd9dd04a287c" },
+  { "AES-CMAC 40 bytes", SID_PAL_AES_CMAC_128, KAT_AES_KEY, NULL,
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46a35ce411",
+    "dfa66747de9ae63030ca32611497c827" },
+  { "AES-CMAC 64 bytes", SID_PAL_AES_CMAC_128, KAT_AES_KEY, NULL,
+    KAT_AES_PLAIN,
+    "51f0bebf7e3b9d92fc49741779363cfe" },
+#endif
+  { "AES-CTR", SID_PAL_AES_CTR_128, KAT_AES_KEY,
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+    KAT_AES_PLAIN,
+    "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+    "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee" },
+};
+
+// GCM specification test case 4 and RFC 3610 packet vector 1
+static const kat_aead_vector_t kat_aead_vectors[] = {
+  { "AES-GCM", SID_PAL_AEAD_GCM_128,
+    "feffe9928665731c6d6a8f9467308308",
+    "cafebabefacedbaddecaf888",
+    "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+    "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+    "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+    "5bc94fbc3221a5db94fae95ae7121a47" },
+  { "AES-CCM", SID_PAL_AEAD_CCM_128,
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf",
+    "00000003020100a0a1a2a3a4a5",
+    "0001020304050607",
+    "08090a0b0c0d0e0f101112131415161718191a1b1c1d1e",
+    "588c979a61c663d2f066d0c2c0f989806d5f6b61dac384",
+    "17e8d12cfdf926e0" },
+};
+
+// RFC 7748 section 6.1 and RFC 5903 section 8.1
+static const kat_ecdh_vector_t kat_ecdh_vectors[] = {
+  { "ECDH X25519", SID_PAL_ECDH_CURVE25519,
+    "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a",
+    "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a",
+    "5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb",
+    "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f",
+    "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742" },
+  { "ECDH P-256", SID_PAL_ECDH_SECP256R1,
+    "c88f01f510d9ac3f70a292daa2316de544e9aab8afe84049c62a9c57862d1433",
+    "dad0b65394221cf9b051e1feca5787d098dfe637fc90b9ef945d0c3772581180"
+    "5271a0461cdb8252d61f1c456fa3e59ab1f45b33accf5f58389e0577b8990bb3",
+    "c6ef9c5d78ae012a011164acb397ce2088685d8f06bf9be0b283ab46476bee53",
+    "d12dfb5289c8d4f81208b70270398c342296970a0bccb74c736fc7554494bf63"
+    "56fbf3ca366cc23e8157854c13c58d6aac23f046ada30f8353e74f33039872ab",
+    "d6840f6b42f6edafd13116e0e12565202fef8e9ece7dce03812464d04b9442de" },
+};
+
+// RFC 6979 appendix A.2.5, SHA-256 with the message "sample"
+#define KAT_ECDSA_PRK "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721"
+#define KAT_ECDSA_PUK "60fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6" \
+                      "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299"
+#define KAT_ECDSA_SIG "efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716" \
+                      "f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8"
+
+#if CRYPTO_BENCH_ED25519
+// RFC 8032 section 7.1, test 2
+#define KAT_ED25519_PRK "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb"
+#define KAT_ED25519_PUK "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c"
+#define KAT_ED25519_MSG "72"
+#define KAT_ED25519_SIG "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da" \
+                        "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"
+#endif
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static kat_buf_t kat_hex(const char *hex)
+{
+  kat_buf_t buf = { 0 };
+  size_t len = strlen(hex);
+
+  if ((len & 1) || (len / 2) > KAT_MAX_SIZE) {
+    fprintf(stderr, "malformed test vector %s\n", hex);
+    exit(EXIT_FAILURE);
+  }
+
+  for (size_t i = 0; i < len / 2; i++) {
+    unsigned int byte;
+    if (sscanf(hex + 2 * i, "%2x", &byte) != 1) {
+      fprintf(stderr, "malformed test vector %s\n", hex);
+      exit(EXIT_FAILURE);
+    }
+    buf.data[i] = (uint8_t)byte;
+  }
+  buf.size = len / 2;
+
+  return buf;
+}
+
+static void kat_report(const char *name, const char *variant, bool pass, sid_error_t ret)
+{
+  char label[64];
+
+  snprintf(label, sizeof(label), "%s %s", name, variant);
+  if (pass) {
+    printf("  %-44s pass\n", label);
+  } else if (ret != SID_ERROR_NONE) {
+    printf("  %-44s FAIL, error %d\n", label, (int)ret);
+    kat_failures++;
+  } else {
+    printf("  %-44s FAIL, unexpected result\n", label);
+    kat_failures++;
+  }
+}
+
+static void kat_check(const char *name, const char *variant, sid_error_t ret,
+                      const uint8_t *out, size_t out_size, const kat_buf_t *expected)
+{
+  bool pass = (ret == SID_ERROR_NONE)
+              && (out_size == expected->size)
+              && (memcmp(out, expected->data, expected->size) == 0);
+
+  kat_report(name, variant, pass, ret);
+}
+
+#if !CRYPTO_BENCH_CMAC || !CRYPTO_BENCH_ED25519
+static void kat_skip(const char *name)
+{
+  printf("  %-44s not supported by the PSA library\n", name);
+}
+#endif
+
+// Three uneven chunks, so that the streams carry partial blocks over
+static void kat_split(const kat_buf_t *buf, sli_sid_pal_crypto_chunk_t chunks[KAT_CHUNKS])
+{
+  size_t first = (buf->size > 1) ? 1 : buf->size;
+  size_t second = (buf->size - first) / 2;
+
+  chunks[0].data = buf->data;
+  chunks[0].size = first;
+  chunks[1].data = buf->data + first;
+  chunks[1].size = second;
+  chunks[2].data = buf->data + first + second;
+  chunks[2].size = buf->size - first - second;
+}
+
+static void kat_rand(void)
+{
+  uint8_t a[32];
+  uint8_t b[32];
+  sid_error_t ret = sid_pal_crypto_rand(a, sizeof(a));
+
+  if (ret == SID_ERROR_NONE) {
+    ret = sid_pal_crypto_rand(b, sizeof(b));
+  }
+  kat_report("rand", "two draws differ", ret == SID_ERROR_NONE && memcmp(a, b, sizeof(a)) != 0, ret);
+}
+
+static void kat_hash(void)
+{
+  for (size_t i = 0; i < sizeof(kat_hash_vectors) / sizeof(kat_hash_vectors[0]); i++) {
+    kat_buf_t msg = { 0 };
+    kat_buf_t expected = kat_hex(kat_hash_vectors[i].digest);
+    uint8_t digest[64];
+    sli_sid_pal_crypto_chunk_t chunks[KAT_CHUNKS];
+    sli_sid_pal_crypto_stream_t stream = { 0 };
+    sid_error_t ret;
+
+    msg.size = strlen(kat_hash_vectors[i].msg);
+    memcpy(msg.data, kat_hash_vectors[i].msg, msg.size);
+
+    sid_pal_hash_params_t params = {
+      .algo = kat_hash_vectors[i].algo,
+      .data = msg.data,
+      .data_size = msg.size,
+      .digest = digest,
+      .digest_size = sizeof(digest),
+    };
+    ret = sid_pal_crypto_hash(&params);
+    kat_check(kat_hash_vectors[i].name, "one-shot", ret, digest, params.digest_size, &expected);
+
+    kat_split(&msg, chunks);
+    ret = sli_sid_pal_crypto_hash_start(&stream, kat_hash_vectors[i].algo);
+    for (size_t c = 0; c < KAT_CHUNKS && ret == SID_ERROR_NONE; c++) {
+      ret = sli_sid_pal_crypto_stream_update(&stream, chunks[c].data, chunks[c].size, NULL, 0, NULL);
+    }
+    if (ret == SID_ERROR_NONE) {
+      ret = sli_sid_pal_crypto_stream_finish(&stream, NULL, 0, NULL, digest, expected.size);
+    }
+    kat_check(kat_hash_vectors[i].name, "stream", ret, digest, expected.size, &expected);
+  }
+}
+
+static void kat_hmac(void)
+{
+  static const char key[] = "Jefe";
+  static const char data[] = "what do ya want for nothing?";
+
+  for (size_t i = 0; i < sizeof(kat_hmac_vectors) / sizeof(kat_hmac_vectors[0]); i++) {
+    kat_buf_t expected = kat_hex(kat_hmac_vectors[i].digest);
+    uint8_t digest[64];
+
+    sid_pal_hmac_params_t params = {
+      .algo = kat_hmac_vectors[i].algo,
+      .key = (const uint8_t *)key,
+      .key_size = strlen(key),
+      .data = (const uint8_t *)data,
+      .data_size = strlen(data),
+      .digest = digest,
+      .digest_size = sizeof(digest),
+    };
+    sid_error_t ret = sid_pal_crypto_hmac(&params);
+    kat_check(kat_hmac_vectors[i].name, "one-shot", ret, digest, params.digest_size, &expected);
+  }
+}
+
+static void kat_aes(void)
+{
+#if !CRYPTO_BENCH_CMAC
+  kat_skip("AES-CMAC");
+#endif
+
+  for (size_t i = 0; i < sizeof(kat_aes_vectors) / sizeof(kat_aes_vectors[0]); i++) {
+    const kat_aes_vector_t *vector = &kat_aes_vectors[i];
+    bool is_mac = (vector->algo == SID_PAL_AES_CMAC_128);
+    kat_buf_t key = kat_hex(vector->key);
+    kat_buf_t iv = vector->iv ? kat_hex(vector->iv) : (kat_buf_t){ 0 };
+    kat_buf_t in = kat_hex(vector->in);
+    kat_buf_t out = kat_hex(vector->out);
+    sli_sid_pal_crypto_chunk_t chunks[KAT_CHUNKS];
+    uint8_t result[KAT_MAX_SIZE];
+    sid_error_t ret;
+
+    sid_pal_aes_params_t params = {
+      .algo = vector->algo,
+      .mode = is_mac ? SID_PAL_CRYPTO_MAC_CALCULATE : SID_PAL_CRYPTO_ENCRYPT,
+      .key = key.data,
+      .key_size = key.size * 8,
+      .iv = iv.data,
+      .iv_size = iv.size,
+      .in = in.data,
+      .in_size = in.size,
+      .out = result,
+      .out_size = sizeof(result),
+    };
+    ret = sid_pal_crypto_aes_crypt(&params);
+    kat_check(vector->name, is_mac ? "one-shot" : "encrypt", ret, result, params.out_size, &out);
+
+    kat_split(&in, chunks);
+    params.out_size = sizeof(result);
+    ret = sli_sid_pal_crypto_aes_crypt_sg(&params, chunks, KAT_CHUNKS);
+    kat_check(vector->name, is_mac ? "scatter-gather" : "encrypt scatter-gather",
+              ret, result, params.out_size, &out);
+
+    if (is_mac) {
+      continue;
+    }
+
+    params.mode = SID_PAL_CRYPTO_DECRYPT;
+    params.in = out.data;
+    params.in_size = out.size;
+    params.out_size = sizeof(result);
+    ret = sid_pal_crypto_aes_crypt(&params);
+    kat_check(vector->name, "decrypt", ret, result, params.out_size, &in);
+
+    kat_split(&out, chunks);
+    params.out_size = sizeof(result);
+    ret = sli_sid_pal_crypto_aes_crypt_sg(&params, chunks, KAT_CHUNKS);
+    kat_check(vector->name, "decrypt scatter-gather", ret, result, params.out_size, &in);
+  }
+}
+
+static void kat_aead(void)
+{
+  for (size_t i = 0; i < sizeof(kat_aead_vectors) / sizeof(kat_aead_vectors[0]); i++) {
+    const kat_aead_vector_t *vector = &kat_aead_vectors[i];
+    kat_buf_t key = kat_hex(vector->key);
+    kat_buf_t iv = kat_hex(vector->iv);
+    kat_buf_t aad = kat_hex(vector->aad);
+    kat_buf_t plain = kat_hex(vector->plain);
+    kat_buf_t cipher = kat_hex(vector->cipher);
+    kat_buf_t tag = kat_hex(vector->tag);
+    sli_sid_pal_crypto_chunk_t aad_chunks[KAT_CHUNKS];
+    sli_sid_pal_crypto_chunk_t in_chunks[KAT_CHUNKS];
+    uint8_t result[KAT_MAX_SIZE];
+    uint8_t mac[16];
+    sid_error_t ret;
+
+    sid_pal_aead_params_t params = {
+      .algo = vector->algo,
+      .mode = SID_PAL_CRYPTO_ENCRYPT,
+      .key = key.data,
+      .key_size = key.size * 8,
+      .iv = iv.data,
+      .iv_size = iv.size,
+      .aad = aad.data,
+      .aad_size = aad.size,
+      .in = plain.data,
+      .in_size = plain.size,
+      .out = result,
+      .out_size = plain.size,
+      .mac = mac,
+      .mac_size = tag.size,
+    };
+    ret = sid_pal_crypto_aead_crypt(&params);
+    kat_check(vector->name, "encrypt", ret, result, params.out_size, &cipher);
+    kat_check(vector->name, "encrypt tag", ret, mac, params.mac_size, &tag);
+
+    kat_split(&aad, aad_chunks);
+    kat_split(&plain, in_chunks);
+    params.out_size = sizeof(result);
+    ret = sli_sid_pal_crypto_aead_crypt_sg(&params, aad_chunks, KAT_CHUNKS, in_chunks, KAT_CHUNKS);
+    kat_check(vector->name, "encrypt scatter-gather", ret, result, params.out_size, &cipher);
+    kat_check(vector->name, "encrypt scatter-gather tag", ret, mac, params.mac_size, &tag);
+
+    params.mode = SID_PAL_CRYPTO_DECRYPT;
+    params.in = cipher.data;
+    params.in_size = cipher.size;
+    params.out_size = cipher.size;
+    memcpy(mac, tag.data, tag.size);
+    ret = sid_pal_crypto_aead_crypt(&params);
+    kat_check(vector->name, "decrypt", ret, result, params.out_size, &plain);
+
+    kat_split(&cipher, in_chunks);
+    params.out_size = sizeof(result);
+    ret = sli_sid_pal_crypto_aead_crypt_sg(&params, aad_chunks, KAT_CHUNKS, in_chunks, KAT_CHUNKS);
+    kat_check(vector->name, "decrypt scatter-gather", ret, result, params.out_size, &plain);
+
+    mac[0] ^= 0x01;
+    params.out_size = cipher.size;
+    ret = sid_pal_crypto_aead_crypt(&params);
+    kat_report(vector->name, "rejects a forged tag", ret != SID_ERROR_NONE, ret);
+
+    params.out_size = sizeof(result);
+    ret = sli_sid_pal_crypto_aead_crypt_sg(&params, aad_chunks, KAT_CHUNKS, in_chunks, KAT_CHUNKS);
+    kat_report(vector->name, "scatter-gather rejects a forged tag", ret != SID_ERROR_NONE, ret);
+  }
+}
+
+static void kat_dsa(const char *name, sid_pal_ecc_algo_t algo,
+                    const char *prk_hex, const char *puk_hex,
+                    const char *msg_hex, const char *sig_hex, bool deterministic)
+{
+  kat_buf_t prk = kat_hex(prk_hex);
+  kat_buf_t puk = kat_hex(puk_hex);
+  kat_buf_t msg = kat_hex(msg_hex);
+  kat_buf_t sig = kat_hex(sig_hex);
+  uint8_t signature[64];
+  sid_error_t ret;
+
+  sid_pal_dsa_params_t params = {
+    .algo = algo,
+    .mode = SID_PAL_CRYPTO_VERIFY,
+    .key = puk.data,
+    .key_size = puk.size,
+    .in = msg.data,
+    .in_size = msg.size,
+    .signature = sig.data,
+    .sig_size = sig.size,
+  };
+  ret = sid_pal_crypto_ecc_dsa(&params);
+  kat_report(name, "verify", ret == SID_ERROR_NONE, ret);
+
+  sig.data[sig.size - 1] ^= 0x01;
+  ret = sid_pal_crypto_ecc_dsa(&params);
+  kat_report(name, "rejects a forged signature", ret != SID_ERROR_NONE, ret);
+  sig.data[sig.size - 1] ^= 0x01;
+
+  params.mode = SID_PAL_CRYPTO_SIGN;
+  params.key = prk.data;
+  params.key_size = prk.size;
+  params.signature = signature;
+  params.sig_size = sizeof(signature);
+  ret = sid_pal_crypto_ecc_dsa(&params);
+  if (deterministic) {
+    kat_check(name, "sign", ret, signature, params.sig_size, &sig);
+    return;
+  }
+
+  // ECDSA signatures are randomized, the new one has to verify
+  if (ret == SID_ERROR_NONE) {
+    params.mode = SID_PAL_CRYPTO_VERIFY;
+    params.key = puk.data;
+    params.key_size = puk.size;
+    ret = sid_pal_crypto_ecc_dsa(&params);
+  }
+  kat_report(name, "sign and verify", ret == SID_ERROR_NONE, ret);
+}
+
+static void kat_ecdsa(void)
+{
+  kat_dsa("ECDSA P-256", SID_PAL_ECDSA_SECP256R1, KAT_ECDSA_PRK, KAT_ECDSA_PUK,
+          "73616d706c65", KAT_ECDSA_SIG, false);
+#if CRYPTO_BENCH_ED25519
+  kat_dsa("Ed25519", SID_PAL_EDDSA_ED25519, KAT_ED25519_PRK, KAT_ED25519_PUK,
+          KAT_ED25519_MSG, KAT_ED25519_SIG, true);
+#else
+  kat_skip("Ed25519");
+#endif
+}
+
+static void kat_ecdh(void)
+{
+  for (size_t i = 0; i < sizeof(kat_ecdh_vectors) / sizeof(kat_ecdh_vectors[0]); i++) {
+    const kat_ecdh_vector_t *vector = &kat_ecdh_vectors[i];
+    kat_buf_t prk_a = kat_hex(vector->prk_a);
+    kat_buf_t puk_a = kat_hex(vector->puk_a);
+    kat_buf_t prk_b = kat_hex(vector->prk_b);
+    kat_buf_t puk_b = kat_hex(vector->puk_b);
+    kat_buf_t shared = kat_hex(vector->shared);
+    uint8_t secret[32];
+    sid_error_t ret;
+
+    sid_pal_ecdh_params_t params = {
+      .algo = vector->algo,
+      .prk = prk_a.data,
+      .prk_size = prk_a.size,
+      .puk = puk_b.data,
+      .puk_size = puk_b.size,
+      .shared_secret = secret,
+      .shared_secret_sz = sizeof(secret),
+    };
+    ret = sid_pal_crypto_ecc_ecdh(&params);
+    kat_check(vector->name, "a to b", ret, secret, params.shared_secret_sz, &shared);
+
+    params.prk = prk_b.data;
+    params.prk_size = prk_b.size;
+    params.puk = puk_a.data;
+    params.puk_size = puk_a.size;
+    params.shared_secret_sz = sizeof(secret);
+    ret = sid_pal_crypto_ecc_ecdh(&params);
+    kat_check(vector->name, "b to a", ret, secret, params.shared_secret_sz, &shared);
+  }
+}
+
+static sid_error_t kat_key_gen_pair(sid_pal_ecc_algo_t algo, kat_buf_t *prk, kat_buf_t *puk)
+{
+  prk->size = 32;
+  puk->size = (algo == SID_PAL_ECDH_SECP256R1 || algo == SID_PAL_ECDSA_SECP256R1) ? 64 : 32;
+
+  sid_pal_ecc_key_gen_params_t params = {
+    .algo = algo,
+    .prk = prk->data,
+    .prk_size = prk->size,
+    .puk = puk->data,
+    .puk_size = puk->size,
+  };
+  return sid_pal_crypto_ecc_key_gen(&params);
+}
+
+// Generated keys have no known answer, they have to work together instead
+static void kat_key_gen(void)
+{
+  static const struct {
+    const char *name;
+    sid_pal_ecc_algo_t algo;
+  } algos[] = {
+    { "key gen X25519", SID_PAL_ECDH_CURVE25519 },
+    { "key gen P-256 ECDH", SID_PAL_ECDH_SECP256R1 },
+    { "key gen P-256 ECDSA", SID_PAL_ECDSA_SECP256R1 },
+#if CRYPTO_BENCH_ED25519
+    { "key gen Ed25519", SID_PAL_EDDSA_ED25519 },
+#endif
+  };
+
+  for (size_t i = 0; i < sizeof(algos) / sizeof(algos[0]); i++) {
+    kat_buf_t prk_a, puk_a, prk_b, puk_b;
+    sid_error_t ret = kat_key_gen_pair(algos[i].algo, &prk_a, &puk_a);
+
+    if (ret == SID_ERROR_NONE) {
+      ret = kat_key_gen_pair(algos[i].algo, &prk_b, &puk_b);
+    }
+    if (ret != SID_ERROR_NONE) {
+      kat_report(algos[i].name, "generate", false, ret);
+      continue;
+    }
+
+    if (algos[i].algo == SID_PAL_ECDH_CURVE25519 || algos[i].algo == SID_PAL_ECDH_SECP256R1) {
+      uint8_t secret_a[32];
+      uint8_t secret_b[32];
+      sid_pal_ecdh_params_t params = {
+        .algo = algos[i].algo,
+        .prk = prk_a.data,
+        .prk_size = prk_a.size,
+        .puk = puk_b.data,
+        .puk_size = puk_b.size,
+        .shared_secret = secret_a,
+        .shared_secret_sz = sizeof(secret_a),
+      };
+      ret = sid_pal_crypto_ecc_ecdh(&params);
+      if (ret == SID_ERROR_NONE) {
+        params.prk = prk_b.data;
+        params.puk = puk_a.data;
+        params.shared_secret = secret_b;
+        ret = sid_pal_crypto_ecc_ecdh(&params);
+      }
+      kat_report(algos[i].name, "agrees",
+                 ret == SID_ERROR_NONE && memcmp(secret_a, secret_b, sizeof(secret_a)) == 0, ret);
+      continue;
+    }
+
+    static const uint8_t msg[] = "sidewalk";
+    uint8_t signature[64];
+    sid_pal_dsa_params_t params = {
+      .algo = algos[i].algo,
+      .mode = SID_PAL_CRYPTO_SIGN,
+      .key = prk_a.data,
+      .key_size = prk_a.size,
+      .in = msg,
+      .in_size = sizeof(msg),
+      .signature = signature,
+      .sig_size = sizeof(signature),
+    };
+    ret = sid_pal_crypto_ecc_dsa(&params);
+    if (ret == SID_ERROR_NONE) {
+      params.mode = SID_PAL_CRYPTO_VERIFY;
+      params.key = puk_a.data;
+      params.key_size = puk_a.size;
+      ret = sid_pal_crypto_ecc_dsa(&params);
+    }
+    kat_report(algos[i].name, "signs", ret == SID_ERROR_NONE, ret);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+int crypto_kat_run(void)
+{
+  kat_failures = 0;
+
+  printf("Known-answer tests:\n");
+  kat_rand();
+  kat_hash();
+  kat_hmac();
+  kat_aes();
+  kat_aead();
+  kat_ecdsa();
+  kat_ecdh();
+  kat_key_gen();
+  printf("%d failure(s)\n\n", kat_failures);
+
+  return kat_failures;
+}
@@ -0,0 +1,8 @@
+// Appended to the default mbedTLS configuration of the fetched library, so
+// that every algorithm the crypto PAL uses is available
+#ifndef MBEDTLS_USER_CONFIG_H
+#define MBEDTLS_USER_CONFIG_H
+
+#define MBEDTLS_CMAC_C
+
+#endif /* MBEDTLS_USER_CONFIG_H */
@@ -0,0 +1,10 @@
+// Host stand-in of the emlib CORE API, the benchmark is single threaded so the
+// atomic sections of the crypto PAL need no protection
+#ifndef EM_CORE_H
+#define EM_CORE_H
+
+#define CORE_DECLARE_IRQ_STATE  int core_irq_state = 0
+#define CORE_ENTER_ATOMIC()     (void)core_irq_state
+#define CORE_EXIT_ATOMIC()      (void)core_irq_state
+
+#endif /* EM_CORE_H */
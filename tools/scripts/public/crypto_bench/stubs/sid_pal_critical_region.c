@@ -0,0 +1,10 @@
+// Host stand-in of the critical region PAL, the benchmark is single threaded
+#include <sid_pal_critical_region_ifc.h>
+
+void sid_pal_enter_critical_region()
+{
+}
+
+void sid_pal_exit_critical_region()
+{
+}
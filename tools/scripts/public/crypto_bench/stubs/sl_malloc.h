@@ -0,0 +1,10 @@
+// Host stand-in of the Silicon Labs memory manager API used by the crypto PAL
+#ifndef SL_MALLOC_H
+#define SL_MALLOC_H
+
+#include <stdlib.h>
+
+#define sl_malloc(size)  malloc(size)
+#define sl_free(ptr)     free(ptr)
+
+#endif /* SL_MALLOC_H */
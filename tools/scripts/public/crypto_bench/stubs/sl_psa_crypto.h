@@ -0,0 +1,14 @@
+// Host stand-in of the Silicon Labs PSA extensions, keys stay in the local
+// key store of the library. Only used with the secure vault, which the
+// benchmark does not enable.
+#ifndef SL_PSA_CRYPTO_H
+#define SL_PSA_CRYPTO_H
+
+#include "psa/crypto.h"
+
+static inline psa_key_location_t sl_psa_get_most_secure_key_location(void)
+{
+  return PSA_KEY_LOCATION_LOCAL_STORAGE;
+}
+
+#endif /* SL_PSA_CRYPTO_H */
@@ -0,0 +1,179 @@
+# !/usr/bin/env python3
+
+import argparse
+import re
+import struct
+import sys
+from elftools.elf.elffile import ELFFile
+
+# Must match log_deferred.h of the sid_pal
+RECORD_LINE_PREFIX = "#SIDLOG:"
+RECORD_FIXED_WORDS = 3
+RECORD_LENGTH_MASK = 0x000000FF
+RECORD_SEVERITY_SHIFT = 8
+RECORD_SEVERITY_MASK = 0x0000007F
+RECORD_TRUNCATED = 0x00008000
+RECORD_SEQUENCE_SHIFT = 16
+
+SEVERITIES = ["<error>", "<warning>", "<info>", "<debug>"]
+
+# Same conversion parsing as the firmware: flags, width, precision, length and conversion
+CONVERSION = re.compile(r"%([-+ #0]*)([0-9.*]*)([hljztL]*)(.?)")
+
+argparser = argparse.ArgumentParser(description="Sidewalk deferred log decoder")
+argparser.add_argument("--elf", help="Firmware image (.axf/.out) the log was recorded with", type=str, required=True)
+argparser.add_argument("--input", help="Captured console output, standard input if omitted", type=str, default=None)
+argparser.add_argument("--output", help="Decoded console output, standard output if omitted", type=str, default=None)
+
+class FormatStrings:
+  def __init__(self, elf_path):
+    self._segments = []
+    with open(elf_path, "rb") as f:
+      elf = ELFFile(f)
+      for section in elf.iter_sections():
+        if section["sh_type"] == "SHT_PROGBITS" and (section["sh_flags"] & 0x2):  # SHF_ALLOC
+          self._segments.append((section["sh_addr"], section.data()))
+    self._cache = {}
+
+  def get(self, address):
+    if address in self._cache:
+      return self._cache[address]
+    for start, data in self._segments:
+      if start <= address < start + len(data):
+        offset = address - start
+        end = data.find(b"\0", offset)
+        if end < 0:
+          end = len(data)
+        fmt = data[offset:end].decode("utf-8", errors="replace")
+        self._cache[address] = fmt
+        return fmt
+    return None
+
+class WordReader:
+  def __init__(self, words):
+    self._words = words
+    self._pos = 0
+
+  def available(self):
+    return len(self._words) - self._pos
+
+  def word(self):
+    word = self._words[self._pos]
+    self._pos += 1
+    return word
+
+  def dword(self):
+    low = self.word()
+    return low | (self.word() << 32)
+
+  def string(self):
+    length = self.word()
+    count = (length + 3) // 4
+    raw = struct.pack("<%dI" % count, *self._words[self._pos:self._pos + count])
+    self._pos += count
+    return raw[:length].decode("utf-8", errors="replace")
+
+def to_signed(value, bits):
+  if value & (1 << (bits - 1)):
+    return value - (1 << bits)
+  return value
+
+def format_record(fmt, reader):
+  out = []
+  pos = 0
+  while True:
+    start = fmt.find("%", pos)
+    if start < 0:
+      out.append(fmt[pos:])
+      break
+    out.append(fmt[pos:start])
+    if fmt.startswith("%%", start):
+      out.append("%")
+      pos = start + 2
+      continue
+    match = CONVERSION.match(fmt, start)
+    flags, width, length, conv = match.groups()
+    pos = match.end()
+    if not conv:
+      out.append(match.group(0))
+      continue
+    try:
+      # An asterisk width or precision takes an int argument
+      while "*" in width:
+        width = width.replace("*", str(to_signed(reader.word(), 32)), 1)
+      long_count = length.count("l") + 2 * length.count("j")
+      spec = "%" + flags + width
+      if conv == "s":
+        out.append((spec + "s") % reader.string())
+      elif conv in "fFeEgGaA":
+        value = struct.unpack("<d", struct.pack("<Q", reader.dword()))[0]
+        out.append((spec + (conv if conv not in "aA" else "e")) % value)
+      else:
+        bits = 64 if long_count >= 2 else 32
+        value = reader.dword() if bits == 64 else reader.word()
+        if conv in "di":
+          out.append((spec + "d") % to_signed(value, bits))
+        elif conv in "uoxX":
+          out.append((spec + ("d" if conv == "u" else conv)) % value)
+        elif conv == "c":
+          out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "p":
+          out.append("0x%08x" % value)
+        else:
+          out.append(match.group(0))
+    except (IndexError, struct.error):
+      # Argument not recorded
+      out.append("<?>")
+  return "".join(out)
+
+def decode_line(line, format_strings, state):
+  index = line.find(RECORD_LINE_PREFIX)
+  if index < 0:
+    return line
+  payload = line[index + len(RECORD_LINE_PREFIX):].strip()
+  try:
+    words = [int(payload[i:i + 8], 16) for i in range(0, len(payload) - 7, 8)]
+  except ValueError:
+    return line
+  if len(words) < RECORD_FIXED_WORDS or (words[0] & RECORD_LENGTH_MASK) != len(words):
+    return line
+
+  header, timestamp, address = words[:RECORD_FIXED_WORDS]
+  severity = (header >> RECORD_SEVERITY_SHIFT) & RECORD_SEVERITY_MASK
+  sequence = header >> RECORD_SEQUENCE_SHIFT
+
+  prefix = line[:index]
+  if state.get("sequence") is not None:
+    missed = (sequence - state["sequence"] - 1) & 0xFFFF
+    if missed:
+      prefix += "<%d records dropped> " % missed
+  state["sequence"] = sequence
+
+  fmt = format_strings.get(address)
+  if fmt is None:
+    text = "<unknown format 0x%08x>" % address
+  else:
+    text = format_record(fmt, WordReader(words[RECORD_FIXED_WORDS:]))
+  if header & RECORD_TRUNCATED:
+    text += " <truncated>"
+  level = SEVERITIES[severity] if severity < len(SEVERITIES) else "<%d>" % severity
+  return "%s[%08u] %s %s\n" % (prefix, timestamp, level, text.rstrip("\r\n"))
+
+def main():
+  args = argparser.parse_args()
+  format_strings = FormatStrings(args.elf)
+  source = open(args.input, "r", errors="replace") if args.input else sys.stdin
+  sink = open(args.output, "w") if args.output else sys.stdout
+  state = {}
+  try:
+    for line in source:
+      sink.write(decode_line(line, format_strings, state))
+      sink.flush()
+  finally:
+    if args.input:
+      source.close()
+    if args.output:
+      sink.close()
+
+if __name__ == "__main__":
+  main()